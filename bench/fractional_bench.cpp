@@ -0,0 +1,475 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "fractional.hpp"
+#include "biginteger.hpp"
+#include "fixedfractional.hpp"
+#include "accumulator.hpp"
+#include "kernels.hpp"
+
+/**
+ * Benchmarks of Fractional arithmetic, printed as JSON:
+ *  plus/minus  - every width of TEST_INTEGRAL, every overflow policy, equal and coprime denominators
+ *  gcd/lcm     - consecutive Fibonacci numbers, the worst case of Euclid
+ *  chain       - long accumulation chains under each normalization policy
+ *  fixed       - prices in cents as FixedFractional and as Fractional
+ *  accumulate  - ledger sums with few distinct denominators, pairwise and with RationalAccumulator
+ *  kernels     - polynomial and dot product, scalar loops and the delayed-reduction kernels
+ *  baseline    - long double and a hand-written struct, with --baseline
+ *
+ * Usage: fractional_bench [--baseline] [--filter substring] [--min-time ms] [--output file]
+ */
+
+#define BENCH_INTEGRAL(function) do {\
+function<signed char>("signed char");\
+function<short>("short");\
+function<int>("int");\
+function<long>("long");\
+function<long long>("long long");\
+function<int8_t>("int8_t");\
+function<int16_t>("int16_t");\
+function<int32_t>("int32_t");\
+function<int64_t>("int64_t");\
+function<ptrdiff_t>("ptrdiff_t");\
+function<char>("char");\
+function<unsigned char>("unsigned char");\
+function<unsigned short>("unsigned short");\
+function<unsigned int>("unsigned int");\
+function<unsigned long>("unsigned long");\
+function<unsigned long long>("unsigned long long");\
+function<uint8_t>("uint8_t");\
+function<uint16_t>("uint16_t");\
+function<uint32_t>("uint32_t");\
+function<uint64_t>("uint64_t");}while(0)
+
+namespace {
+    using namespace fractional;
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        bool baseline = false;
+        std::string filter;
+        double min_time_ms = 50;
+        std::string output;
+    };
+
+    struct Result {
+        std::string name;
+        std::string group;
+        std::string type;
+        std::string variant;
+        std::size_t operations;
+        double ns_per_op;
+    };
+
+    Options options;
+    std::vector<Result> results;
+
+    template<class T>
+    void DoNotOptimize(const T &value) {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+
+    /**
+     * Repeats body() until min_time_ms has passed, body performs operations_per_call operations
+     */
+    template<class _Body>
+    void Run(const std::string &group, const std::string &type, const std::string &variant,
+             std::size_t operations_per_call, _Body body) {
+        auto name = group + "/" + type + "/" + variant;
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos)
+            return;
+
+        body();
+        std::size_t calls = 0;
+        auto start = Clock::now();
+        std::chrono::duration<double, std::milli> elapsed{};
+        do {
+            body();
+            ++calls;
+            elapsed = Clock::now() - start;
+        } while (elapsed.count() < options.min_time_ms);
+
+        auto operations = calls * operations_per_call;
+        results.push_back({name, group, type, variant, operations, elapsed.count() * 1e6 / double(operations)});
+    }
+
+    /**
+     * lhs[i] - rhs[i] stays positive and every result fits 8 bits: 4/p -+ 1/q with p, q in {2, 3, 5, 7}
+     */
+    template<class _Fract>
+    void MakeInputs(bool equal, std::vector<_Fract> &lhs, std::vector<_Fract> &rhs) {
+        using NaturalType = typename _Fract::NaturalType;
+        const int primes[] = {2, 3, 5, 7};
+        for (int i = 0; i < 1024; ++i) {
+            auto p = primes[i % 4];
+            auto q = equal ? p : primes[(i + 1 + i / 4 % 3) % 4];
+            lhs.emplace_back(NaturalType(4), NaturalType(p));
+            rhs.emplace_back(NaturalType(1), NaturalType(q));
+        }
+    }
+
+    template<class _Fract>
+    void BenchArithmetic(const std::string &type, const std::string &policy) {
+        for (bool equal : {true, false}) {
+            std::vector<_Fract> lhs, rhs;
+            MakeInputs(equal, lhs, rhs);
+            auto inputs = std::string(equal ? "equal" : "coprime");
+
+            Run("plus", type, policy + "/" + inputs, lhs.size(), [&] {
+                for (std::size_t i = 0; i < lhs.size(); ++i) {
+                    auto result = lhs[i] + rhs[i];
+                    DoNotOptimize(result);
+                }
+            });
+            Run("minus", type, policy + "/" + inputs, lhs.size(), [&] {
+                for (std::size_t i = 0; i < lhs.size(); ++i) {
+                    auto result = lhs[i] - rhs[i];
+                    DoNotOptimize(result);
+                }
+            });
+        }
+    }
+
+    template<class T>
+    void BenchPolicies(const char *type) {
+        BenchArithmetic<Fractional<T>>(type, "ThrowOnCheck");
+        BenchArithmetic<Fractional<T, overflow::NoCheck>>(type, "NoCheck");
+        BenchArithmetic<Fractional<T, overflow::ThrowOnCheck, overflow::CheckNoOverflow>>(type, "CheckNoOverflow");
+        BenchArithmetic<Fractional<T, overflow::BuiltinThrowOnCheck, overflow::BuiltinCheckOverflow>>(
+                type, "BuiltinThrowOnCheck");
+        BenchArithmetic<Fractional<T, overflow::FlagOnCheck>>(type, "FlagOnCheck");
+    }
+
+    /**
+     * Largest pair of consecutive Fibonacci numbers representable in T
+     */
+    template<class T>
+    std::pair<T, T> Fibonacci() {
+        T previous = 1, current = 1, next{};
+        while (!__builtin_add_overflow(previous, current, &next)) {
+            previous = current;
+            current = next;
+        }
+        return {previous, current};
+    }
+
+    template<class T>
+    void BenchGcd(const std::string &type) {
+        using UType = std::make_unsigned_t<T>;
+        auto [lhs, rhs] = Fibonacci<T>();
+        const std::size_t repeat = 256;
+
+        Run("gcd", type, "utility::gcd", repeat, [&] {
+            for (std::size_t i = 0; i < repeat; ++i) {
+                DoNotOptimize(utility::gcd<T, overflow::ThrowOnCheck<T>>(lhs, rhs));
+            }
+        });
+        Run("gcd", type, "BinaryGcd", repeat, [&] {
+            for (std::size_t i = 0; i < repeat; ++i) {
+                DoNotOptimize(utility::BinaryGcd(UType(lhs), UType(rhs)));
+            }
+        });
+        Run("gcd", type, "LehmerGcd", repeat, [&] {
+            for (std::size_t i = 0; i < repeat; ++i) {
+                DoNotOptimize(utility::LehmerGcd(UType(lhs), UType(rhs)));
+            }
+        });
+        Run("gcd", type, "EuclidGcd", repeat, [&] {
+            for (std::size_t i = 0; i < repeat; ++i) {
+                DoNotOptimize(utility::EuclidGcd<T, overflow::NoCheck<T>>(lhs, rhs));
+            }
+        });
+        Run("lcm", type, "utility::lcm", repeat, [&] {
+            for (std::size_t i = 0; i < repeat; ++i) {
+                DoNotOptimize(utility::lcm<T, overflow::NoCheck<T>>(lhs, rhs));
+            }
+        });
+    }
+
+    /**
+     * Telescoping sum of 1/(k(k+1)), k < length: the exact result 1 - 1/length keeps every width in range
+     */
+    template<class _Fract>
+    void BenchChain(const std::string &type, const std::string &normalization, int length) {
+        using NaturalType = typename _Fract::NaturalType;
+        std::vector<_Fract> terms;
+        for (int k = 1; k < length; ++k) {
+            terms.emplace_back(NaturalType(1), NaturalType(k) * NaturalType(k + 1));
+        }
+        Run("chain", type, normalization + "/" + std::to_string(length), terms.size(), [&] {
+            _Fract sum{NaturalType(0), NaturalType(1)};
+            for (const auto &term : terms) {
+                sum += term;
+            }
+            DoNotOptimize(sum);
+        });
+    }
+
+    void BenchChains() {
+        using overflow::ThrowOnCheck;
+        using overflow::IntegralCheckOverflow;
+        for (int length : {64, 1024}) {
+            BenchChain<Fractional<std::int64_t>>("int64_t", "Eager", length);
+            BenchChain<Fractional<std::int64_t, ThrowOnCheck, IntegralCheckOverflow, normalization::Lazy<>>>(
+                    "int64_t", "Lazy", length);
+            BenchChain<big_fraction>("BigInteger", "Eager", length);
+        }
+
+    /*
+     * Harmonic numbers: denominators grow without bound
+     */
+        std::vector<big_fraction> terms;
+        for (int k = 1; k <= 256; ++k) {
+            terms.emplace_back(1, k);
+        }
+        Run("chain", "BigInteger", "harmonic/256", terms.size(), [&] {
+            big_fraction sum{0, 1};
+            for (const auto &term : terms) {
+                sum += term;
+            }
+            DoNotOptimize(sum);
+        });
+    }
+
+    /**
+     * Sums and products of prices in cents, the Fractional inputs all have denominator 100
+     */
+    void BenchFixed() {
+        using cents = FixedFractional<std::int64_t, 100>;
+        std::vector<cents> fixed;
+        std::vector<Fractional<std::int64_t>> general;
+        for (std::int64_t i = 0; i < 1024; ++i) {
+            fixed.push_back(cents::from_nominator(i * 37 % 1000 + 1));
+            general.emplace_back(fixed.back().nominator(), 100);
+        }
+
+        Run("fixed", "int64_t", "FixedFractional/plus", fixed.size(), [&] {
+            auto sum = cents(0);
+            for (const auto &value : fixed) {
+                sum += value;
+            }
+            DoNotOptimize(sum);
+        });
+        Run("fixed", "int64_t", "Fractional/plus", general.size(), [&] {
+            Fractional<std::int64_t> sum{0, 1};
+            for (const auto &value : general) {
+                sum += value;
+            }
+            DoNotOptimize(sum);
+        });
+        Run("fixed", "int64_t", "FixedFractional/multiply", fixed.size(), [&] {
+            for (std::size_t i = 0; i + 1 < fixed.size(); ++i) {
+                DoNotOptimize(fixed[i] * fixed[i + 1]);
+            }
+        });
+        Run("fixed", "int64_t", "Fractional/multiply", general.size(), [&] {
+            for (std::size_t i = 0; i + 1 < general.size(); ++i) {
+                DoNotOptimize(general[i] * general[i + 1]);
+            }
+        });
+    }
+
+    /**
+     * Ledger amounts in 1/100, 1/12, 1/7 and 1/3: a dozen distinct reduced denominators over 1024 terms
+     */
+    template<class _Fract>
+    void BenchAccumulate(const std::string &type) {
+        using NaturalType = typename _Fract::NaturalType;
+        const int denominators[] = {100, 12, 7, 3};
+        std::vector<_Fract> terms;
+        for (int i = 0; i < 1024; ++i) {
+            terms.emplace_back(NaturalType(i * 37 % 1000 - 500), NaturalType(denominators[i % 4]));
+        }
+
+        Run("accumulate", type, "pairwise", terms.size(), [&] {
+            _Fract sum{NaturalType(0), NaturalType(1)};
+            for (const auto &term : terms) {
+                sum += term;
+            }
+            DoNotOptimize(sum);
+        });
+        Run("accumulate", type, "RationalAccumulator", terms.size(), [&] {
+            RationalAccumulator<_Fract> sum;
+            sum.add(terms.begin(), terms.end());
+            DoNotOptimize(sum.result());
+        });
+    }
+
+    /**
+     * Degree 7 polynomial at 2/3 and a dot product of 1024 small fractions
+     */
+    template<class _Fract>
+    void BenchKernels(const std::string &type) {
+        using NaturalType = typename _Fract::NaturalType;
+        std::vector<_Fract> coefficients, lhs, rhs;
+        for (int i = 0; i < 8; ++i) {
+            coefficients.emplace_back(NaturalType(i + 1), NaturalType(i % 3 + 2));
+        }
+        for (int i = 0; i < 1024; ++i) {
+            lhs.emplace_back(NaturalType(i % 7 + 1), NaturalType(i % 4 + 1));
+            rhs.emplace_back(NaturalType(i % 5 + 1), NaturalType(i % 3 + 1));
+        }
+        _Fract x{NaturalType(2), NaturalType(3)};
+
+        Run("kernels", type, "horner/scalar", coefficients.size(), [&] {
+            auto value = coefficients.back();
+            for (auto i = coefficients.size() - 1; i-- > 0;) {
+                value = value * x + coefficients[i];
+            }
+            DoNotOptimize(value);
+        });
+        Run("kernels", type, "horner/delayed", coefficients.size(), [&] {
+            DoNotOptimize(horner(coefficients, x));
+        });
+        Run("kernels", type, "dot/scalar", lhs.size(), [&] {
+            _Fract sum{NaturalType(0), NaturalType(1)};
+            for (std::size_t i = 0; i < lhs.size(); ++i) {
+                sum += lhs[i] * rhs[i];
+            }
+            DoNotOptimize(sum);
+        });
+        Run("kernels", type, "dot/delayed", lhs.size(), [&] {
+            DoNotOptimize(dot(lhs, rhs));
+        });
+    }
+
+    struct PlainFraction {
+        long long nominator;
+        long long denominator;
+    };
+
+    PlainFraction PlainPlus(const PlainFraction &lhs, const PlainFraction &rhs) {
+        auto nominator = lhs.nominator * rhs.denominator + rhs.nominator * lhs.denominator;
+        auto denominator = lhs.denominator * rhs.denominator;
+        auto gcd = std::gcd(nominator, denominator);
+        return {nominator / gcd, denominator / gcd};
+    }
+
+    void BenchBaselines() {
+        for (bool equal : {true, false}) {
+            std::vector<Fractional<long long>> lhs, rhs;
+            MakeInputs(equal, lhs, rhs);
+            auto inputs = std::string(equal ? "equal" : "coprime");
+
+            std::vector<long double> lhs_float, rhs_float;
+            std::vector<PlainFraction> lhs_plain, rhs_plain;
+            for (std::size_t i = 0; i < lhs.size(); ++i) {
+                lhs_float.push_back((long double) lhs[i].nominator() / lhs[i].denominator());
+                rhs_float.push_back((long double) rhs[i].nominator() / rhs[i].denominator());
+                lhs_plain.push_back({lhs[i].nominator(), lhs[i].denominator()});
+                rhs_plain.push_back({rhs[i].nominator(), rhs[i].denominator()});
+            }
+
+            Run("baseline", "long double", "plus/" + inputs, lhs.size(), [&] {
+                for (std::size_t i = 0; i < lhs_float.size(); ++i) {
+                    auto result = lhs_float[i] + rhs_float[i];
+                    DoNotOptimize(result);
+                }
+            });
+            Run("baseline", "PlainFraction", "plus/" + inputs, lhs.size(), [&] {
+                for (std::size_t i = 0; i < lhs_plain.size(); ++i) {
+                    auto result = PlainPlus(lhs_plain[i], rhs_plain[i]);
+                    DoNotOptimize(result);
+                }
+            });
+        }
+    }
+
+    std::string Escape(const std::string &value) {
+        std::string escaped;
+        for (auto c : value) {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    void WriteJson(std::ostream &os) {
+        os << "{\n  \"context\": {\n";
+        os << "    \"compiler\": \"" << Escape(__VERSION__) << "\",\n";
+#ifdef NDEBUG
+        os << "    \"assertions\": false,\n";
+#else
+        os << "    \"assertions\": true,\n";
+#endif
+        os << "    \"min_time_ms\": " << options.min_time_ms << "\n  },\n";
+        os << "  \"benchmarks\": [";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const auto &result = results[i];
+            os << (i == 0 ? "\n" : ",\n");
+            os << "    {\"name\": \"" << Escape(result.name) << "\", \"group\": \"" << Escape(result.group)
+               << "\", \"type\": \"" << Escape(result.type) << "\", \"variant\": \"" << Escape(result.variant)
+               << "\", \"operations\": " << result.operations << ", \"ns_per_op\": " << result.ns_per_op << "}";
+        }
+        os << "\n  ]\n}\n";
+    }
+
+    bool ParseOptions(int argc, char *argv[]) {
+        for (int i = 1; i < argc; ++i) {
+            auto has_value = i + 1 < argc;
+            if (std::strcmp(argv[i], "--baseline") == 0) {
+                options.baseline = true;
+            } else if (std::strcmp(argv[i], "--filter") == 0 && has_value) {
+                options.filter = argv[++i];
+            } else if (std::strcmp(argv[i], "--min-time") == 0 && has_value) {
+                options.min_time_ms = std::stod(argv[++i]);
+            } else if (std::strcmp(argv[i], "--output") == 0 && has_value) {
+                options.output = argv[++i];
+            } else {
+                std::cerr << "Usage: " << argv[0]
+                          << " [--baseline] [--filter substring] [--min-time ms] [--output file]\n";
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    if (!ParseOptions(argc, argv))
+        return 2;
+
+    BENCH_INTEGRAL(BenchPolicies);
+
+    BenchGcd<std::int32_t>("int32_t");
+    BenchGcd<std::int64_t>("int64_t");
+    BenchGcd<std::uint64_t>("uint64_t");
+    BenchGcd<__int128>("__int128");
+
+    BenchChains();
+
+    BenchFixed();
+
+    BenchAccumulate<Fractional<std::int64_t>>("int64_t");
+    BenchAccumulate<big_fraction>("BigInteger");
+
+    BenchKernels<Fractional<std::int64_t>>("int64_t");
+    BenchKernels<big_fraction>("BigInteger");
+
+    if (options.baseline)
+        BenchBaselines();
+
+    if (options.output.empty()) {
+        WriteJson(std::cout);
+    } else {
+        std::ofstream file(options.output);
+        WriteJson(file);
+        if (!file) {
+            std::cerr << "Cannot write " << options.output << "\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_ACCUMULATOR_HPP
+#define FRACTIONNUMBER_ACCUMULATOR_HPP
+
+#include <cstddef>
+#include <vector>
+#include "fractional.hpp"
+
+/**
+ * Sums of many terms with few distinct denominators. Terms are grouped by denominator in a small
+ * open-addressing table and only their nominators are added, a checked integer add per term.
+ * The groups are merged into the total with k lcm for k distinct denominators, when the result
+ * is read or the table is 3/4 full, instead of one lcm per term of the pairwise sum.
+ */
+NAMESPACE_FRACTIONAL_BEGIN
+    template<class _Fract>
+    class RationalAccumulator {
+    public:
+        using Fraction = _Fract;
+        using NaturalType = typename _Fract::NaturalType;
+
+        static constexpr std::size_t DefaultCapacity = 16;
+
+        /**
+         * Table of capacity slots rounded up to a power of two, at least 4
+         */
+        explicit RationalAccumulator(std::size_t capacity = DefaultCapacity);
+
+        RationalAccumulator &operator+=(const Fraction &value);
+
+        RationalAccumulator &operator-=(const Fraction &value);
+
+        /**
+         * Adds every term of [first, last)
+         */
+        template<class _InputIt>
+        RationalAccumulator &add(_InputIt first, _InputIt last);
+
+        /**
+         * Exact sum of the terms so far, merges the pending groups into it.
+         * If the checker throws, the accumulator keeps its terms unmerged.
+         */
+        Fraction result();
+
+        /**
+         * Distinct denominators not merged yet
+         */
+        std::size_t pending() const noexcept;
+
+        void clear();
+
+    private:
+        struct Group {
+            NaturalType denominator{};
+            NaturalType nominator{};
+            bool occupied = false;
+        };
+
+        /**
+         * group.nominator = _Operator(group.nominator, value.nominator()) for the group of value.denominator()
+         */
+        template<class _Operator>
+        void Insert(const Fraction &value);
+
+        void Merge();
+
+        std::vector<Group> groups_;
+        std::size_t pending_ = 0;
+        Fraction total_;
+    };
+NAMESPACE_FRACTIONAL_END
+
+#include "accumulator.hxx"
+
+#endif //FRACTIONNUMBER_ACCUMULATOR_HPP
@@ -0,0 +1,110 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_ACCUMULATOR_HXX
+#define FRACTIONNUMBER_ACCUMULATOR_HXX
+
+#include <utility>
+#include "accumulator.hpp"
+
+NAMESPACE_FRACTIONAL_BEGIN
+    template<class _Fract>
+    RationalAccumulator<_Fract>::RationalAccumulator(std::size_t capacity)
+            : total_(NaturalType(0), NaturalType(1)) {
+        std::size_t size = 4;
+        while (size < capacity) {
+            size <<= 1u;
+        }
+        groups_.resize(size);
+    }
+
+    template<class _Fract>
+    RationalAccumulator<_Fract> &RationalAccumulator<_Fract>::operator+=(const Fraction &value) {
+        Insert<typename Fraction::PlusOperator>(value);
+        return *this;
+    }
+
+    template<class _Fract>
+    RationalAccumulator<_Fract> &RationalAccumulator<_Fract>::operator-=(const Fraction &value) {
+        Insert<typename Fraction::MinusOperator>(value);
+        return *this;
+    }
+
+    template<class _Fract>
+    template<class _InputIt>
+    RationalAccumulator<_Fract> &RationalAccumulator<_Fract>::add(_InputIt first, _InputIt last) {
+        for (; first != last; ++first) {
+            *this += *first;
+        }
+        return *this;
+    }
+
+    template<class _Fract>
+    _Fract RationalAccumulator<_Fract>::result() {
+        Merge();
+        return total_;
+    }
+
+    template<class _Fract>
+    std::size_t RationalAccumulator<_Fract>::pending() const noexcept {
+        return pending_;
+    }
+
+    template<class _Fract>
+    void RationalAccumulator<_Fract>::clear() {
+        for (auto &group : groups_) {
+            group = Group{};
+        }
+        pending_ = 0;
+        total_ = Fraction(NaturalType(0), NaturalType(1));
+    }
+
+    template<class _Fract>
+    template<class _Operator>
+    void RationalAccumulator<_Fract>::Insert(const Fraction &value) {
+        typename Fraction::EqualOperator equal;
+        auto mask = groups_.size() - 1;
+        auto slot = HashValue(value.denominator()) & mask;
+        while (groups_[slot].occupied && !equal(groups_[slot].denominator, value.denominator())) {
+            slot = (slot + 1) & mask;
+        }
+
+    /*
+     * A new denominator that would fill the table past 3/4 merges every group first
+     */
+        if (!groups_[slot].occupied) {
+            if (pending_ == groups_.size() / 4 * 3) {
+                Merge();
+                slot = HashValue(value.denominator()) & mask;
+            }
+            groups_[slot].denominator = value.denominator();
+            groups_[slot].occupied = true;
+            ++pending_;
+        }
+        groups_[slot].nominator = _Operator{}(groups_[slot].nominator, value.nominator());
+    }
+
+    template<class _Fract>
+    void RationalAccumulator<_Fract>::Merge() {
+        typename Fraction::NoEqualOperator not_equal;
+
+    /*
+     * The groups are summed into a copy of the total, so an overflow leaves the accumulator as it was
+     */
+        auto total = total_;
+        for (const auto &group : groups_) {
+            if (group.occupied && not_equal(group.nominator, NaturalType(0))) {
+                total += Fraction(group.nominator, group.denominator);
+            }
+        }
+        for (auto &group : groups_) {
+            group.nominator = NaturalType(0);
+            group.occupied = false;
+        }
+        pending_ = 0;
+        total_ = std::move(total);
+    }
+NAMESPACE_FRACTIONAL_END
+
+#endif //FRACTIONNUMBER_ACCUMULATOR_HXX
@@ -0,0 +1,136 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_ATOMICFRACTIONAL_HPP
+#define FRACTIONNUMBER_ATOMICFRACTIONAL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "fractional.hpp"
+
+/**
+ * Shared fractions updated by many threads without a lock. AtomicFractional packs nominator and
+ * denominator of at most 32 bits each into one 64-bit word, read-modify-write operations are CAS
+ * loops around the scalar Fractional operations, so results and overflow reporting are those of
+ * the configured checker. ShardedFractional spreads a heavily contended counter over
+ * cache-line-sized shards and combines them only on read.
+ */
+NAMESPACE_FRACTIONAL_BEGIN
+    template<class _Fract>
+    class AtomicFractional {
+    public:
+        using Fraction = _Fract;
+        using NaturalType = typename _Fract::NaturalType;
+
+        static_assert(std::is_integral_v<NaturalType> && sizeof(NaturalType) <= 4,
+                      "AtomicFractional packs built-in NaturalType of at most 32 bits");
+
+        static constexpr bool is_always_lock_free = std::atomic<std::uint64_t>::is_always_lock_free;
+
+        /**
+         * Holds 0/1
+         */
+        AtomicFractional() noexcept;
+
+        explicit AtomicFractional(const Fraction &value) noexcept;
+
+        AtomicFractional(const AtomicFractional &) = delete;
+
+        AtomicFractional &operator=(const AtomicFractional &) = delete;
+
+        Fraction load(std::memory_order order = std::memory_order_seq_cst) const noexcept;
+
+        void store(const Fraction &value, std::memory_order order = std::memory_order_seq_cst) noexcept;
+
+        Fraction exchange(const Fraction &value, std::memory_order order = std::memory_order_seq_cst) noexcept;
+
+        /**
+         * Compares representations like std::atomic: under deferring normalizations 2/4 does not match 1/2.
+         * On failure expected receives the current value.
+         */
+        bool compare_exchange_weak(Fraction &expected, const Fraction &desired,
+                                   std::memory_order success = std::memory_order_seq_cst,
+                                   std::memory_order failure = std::memory_order_seq_cst);
+
+        bool compare_exchange_strong(Fraction &expected, const Fraction &desired,
+                                     std::memory_order success = std::memory_order_seq_cst,
+                                     std::memory_order failure = std::memory_order_seq_cst);
+
+        /**
+         * Stores current + value computed by Plus and returns current. If the checker throws,
+         * the exception propagates and the stored value is left as it was.
+         */
+        Fraction fetch_add(const Fraction &value, std::memory_order order = std::memory_order_seq_cst);
+
+        Fraction fetch_sub(const Fraction &value, std::memory_order order = std::memory_order_seq_cst);
+
+        /**
+         * @return the new value
+         */
+        Fraction operator+=(const Fraction &value);
+
+        Fraction operator-=(const Fraction &value);
+
+        bool is_lock_free() const noexcept;
+
+    private:
+        static std::uint64_t Pack(const Fraction &value) noexcept;
+
+        static Fraction Unpack(std::uint64_t word) noexcept;
+
+        /**
+         * CAS loop storing operation(current) and returning current
+         */
+        template<class _Operation>
+        Fraction FetchApply(_Operation operation, std::memory_order order);
+
+        std::atomic<std::uint64_t> word_;
+    };
+
+    template<class _Fract>
+    class ShardedFractional {
+    public:
+        using Fraction = _Fract;
+
+        static constexpr std::size_t CacheLine = 64;
+
+        /**
+         * shards == 0 takes std::thread::hardware_concurrency
+         */
+        explicit ShardedFractional(std::size_t shards = 0);
+
+        /**
+         * Adds value to the shard of the calling thread
+         */
+        void add(const Fraction &value);
+
+        void subtract(const Fraction &value);
+
+        /**
+         * Sum of the shards. Not a snapshot: concurrent updates may be partly included.
+         */
+        Fraction load() const;
+
+        std::size_t shards() const noexcept;
+
+    private:
+        struct alignas(CacheLine) Shard {
+            AtomicFractional<Fraction> value;
+        };
+
+        /**
+         * Index given to the calling thread on its first update, threads take consecutive indices
+         */
+        static std::size_t ThreadIndex() noexcept;
+
+        std::vector<Shard> shards_;
+    };
+NAMESPACE_FRACTIONAL_END
+
+#include "atomicfractional.hxx"
+
+#endif //FRACTIONNUMBER_ATOMICFRACTIONAL_HPP
@@ -0,0 +1,155 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_ATOMICFRACTIONAL_HXX
+#define FRACTIONNUMBER_ATOMICFRACTIONAL_HXX
+
+#include <algorithm>
+#include <thread>
+#include "atomicfractional.hpp"
+
+NAMESPACE_FRACTIONAL_BEGIN
+    template<class _Fract>
+    AtomicFractional<_Fract>::AtomicFractional() noexcept : word_(1) {}
+
+    template<class _Fract>
+    AtomicFractional<_Fract>::AtomicFractional(const Fraction &value) noexcept : word_(Pack(value)) {}
+
+    template<class _Fract>
+    _Fract AtomicFractional<_Fract>::load(std::memory_order order) const noexcept {
+        return Unpack(word_.load(order));
+    }
+
+    template<class _Fract>
+    void AtomicFractional<_Fract>::store(const Fraction &value, std::memory_order order) noexcept {
+        word_.store(Pack(value), order);
+    }
+
+    template<class _Fract>
+    _Fract AtomicFractional<_Fract>::exchange(const Fraction &value, std::memory_order order) noexcept {
+        return Unpack(word_.exchange(Pack(value), order));
+    }
+
+    template<class _Fract>
+    bool AtomicFractional<_Fract>::compare_exchange_weak(Fraction &expected, const Fraction &desired,
+                                                         std::memory_order success, std::memory_order failure) {
+        auto word = Pack(expected);
+        if (word_.compare_exchange_weak(word, Pack(desired), success, failure))
+            return true;
+        expected = Unpack(word);
+        return false;
+    }
+
+    template<class _Fract>
+    bool AtomicFractional<_Fract>::compare_exchange_strong(Fraction &expected, const Fraction &desired,
+                                                           std::memory_order success, std::memory_order failure) {
+        auto word = Pack(expected);
+        if (word_.compare_exchange_strong(word, Pack(desired), success, failure))
+            return true;
+        expected = Unpack(word);
+        return false;
+    }
+
+    template<class _Fract>
+    _Fract AtomicFractional<_Fract>::fetch_add(const Fraction &value, std::memory_order order) {
+        return FetchApply([&value](const Fraction &current) {
+            return Plus(current, value);
+        }, order);
+    }
+
+    template<class _Fract>
+    _Fract AtomicFractional<_Fract>::fetch_sub(const Fraction &value, std::memory_order order) {
+        return FetchApply([&value](const Fraction &current) {
+            return Minus(current, value);
+        }, order);
+    }
+
+    template<class _Fract>
+    _Fract AtomicFractional<_Fract>::operator+=(const Fraction &value) {
+        return Plus(fetch_add(value), value);
+    }
+
+    template<class _Fract>
+    _Fract AtomicFractional<_Fract>::operator-=(const Fraction &value) {
+        return Minus(fetch_sub(value), value);
+    }
+
+    template<class _Fract>
+    bool AtomicFractional<_Fract>::is_lock_free() const noexcept {
+        return word_.is_lock_free();
+    }
+
+    /**
+     * Nominator in the high half, denominator in the low half, each as the unsigned 32-bit pattern.
+     * Only values of Fraction are packed, so Unpack restores them without checks or normalization.
+     */
+    template<class _Fract>
+    std::uint64_t AtomicFractional<_Fract>::Pack(const Fraction &value) noexcept {
+        using UType = std::make_unsigned_t<NaturalType>;
+        return std::uint64_t(std::uint32_t(UType(value.nominator()))) << 32u |
+               std::uint32_t(UType(value.denominator()));
+    }
+
+    template<class _Fract>
+    _Fract AtomicFractional<_Fract>::Unpack(std::uint64_t word) noexcept {
+        using UType = std::make_unsigned_t<NaturalType>;
+        return Fraction(NaturalType(UType(word >> 32u)), NaturalType(UType(word)),
+                        typename Fraction::CanonicalTag{});
+    }
+
+    template<class _Fract>
+    template<class _Operation>
+    _Fract AtomicFractional<_Fract>::FetchApply(_Operation operation, std::memory_order order) {
+    /*
+     * The failure order may not be a release order
+     */
+        auto failure = order == std::memory_order_acq_rel ? std::memory_order_acquire :
+                       order == std::memory_order_release ? std::memory_order_relaxed : order;
+        auto word = word_.load(failure);
+        while (true) {
+            auto current = Unpack(word);
+            if (word_.compare_exchange_weak(word, Pack(operation(current)), order, failure))
+                return current;
+        }
+    }
+
+    template<class _Fract>
+    ShardedFractional<_Fract>::ShardedFractional(std::size_t shards)
+            : shards_(shards != 0 ? shards : std::max<std::size_t>(1, std::thread::hardware_concurrency())) {}
+
+    template<class _Fract>
+    void ShardedFractional<_Fract>::add(const Fraction &value) {
+        shards_[ThreadIndex() % shards_.size()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    template<class _Fract>
+    void ShardedFractional<_Fract>::subtract(const Fraction &value) {
+        shards_[ThreadIndex() % shards_.size()].value.fetch_sub(value, std::memory_order_relaxed);
+    }
+
+    template<class _Fract>
+    _Fract ShardedFractional<_Fract>::load() const {
+        using NaturalType = typename Fraction::NaturalType;
+
+        Fraction sum{NaturalType(0), NaturalType(1)};
+        for (const auto &shard : shards_) {
+            sum += shard.value.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    template<class _Fract>
+    std::size_t ShardedFractional<_Fract>::shards() const noexcept {
+        return shards_.size();
+    }
+
+    template<class _Fract>
+    std::size_t ShardedFractional<_Fract>::ThreadIndex() noexcept {
+        static std::atomic<std::size_t> next{0};
+        thread_local auto index = next.fetch_add(1, std::memory_order_relaxed);
+        return index;
+    }
+NAMESPACE_FRACTIONAL_END
+
+#endif //FRACTIONNUMBER_ATOMICFRACTIONAL_HXX
@@ -0,0 +1,274 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_BIGINTEGER_HPP
+#define FRACTIONNUMBER_BIGINTEGER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "blockcache.hpp"
+#include "fractional.hpp"
+
+NAMESPACE_FRACTIONAL_BEGIN
+    /**
+     * Arbitrary-precision signed integer satisfying the NaturalType contract.
+     * Values fitting std::int64_t are stored inline without heap allocation,
+     * wider values keep sign and magnitude in little-endian 32-bit limbs.
+     * Every operation leaves the value in inline form whenever it fits, so equal values
+     * have equal representations. Limbs are allocated through memory::BlockCache, temporaries
+     * of arithmetic reuse the blocks of earlier ones.
+     */
+    class BigInteger {
+    public:
+        using Limb = std::uint32_t;
+        using Limbs = std::vector<Limb, memory::CachingAllocator<Limb>>;
+
+        BigInteger() noexcept = default;
+
+        template<class T, typename = std::enable_if_t<std::is_integral_v<T>>>
+        BigInteger(T value);
+
+        BigInteger(const BigInteger &) = default;
+
+        BigInteger(BigInteger &&) noexcept = default;
+
+        BigInteger &operator=(const BigInteger &) = default;
+
+        BigInteger &operator=(BigInteger &&) noexcept = default;
+
+        /**
+         * @return value modulo 2^digits of T, like a built-in narrowing conversion
+         */
+        template<class T, typename std::enable_if_t<std::is_integral_v<T>, int> = 0>
+        explicit operator T() const noexcept;
+
+        template<class T, typename std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+        explicit operator T() const noexcept;
+
+        /**
+         * @return true if value is stored inline, without limbs
+         */
+        bool is_inline() const noexcept {
+            return limbs_.empty();
+        }
+
+        /**
+         * @return -1, 0 or 1
+         */
+        int sign() const noexcept;
+
+        friend BigInteger operator+(const BigInteger &lhs, const BigInteger &rhs);
+
+        friend BigInteger operator-(const BigInteger &lhs, const BigInteger &rhs);
+
+        friend BigInteger operator*(const BigInteger &lhs, const BigInteger &rhs);
+
+        /**
+         * Truncating division, throws std::domain_error on zero divisor
+         */
+        friend BigInteger operator/(const BigInteger &lhs, const BigInteger &rhs);
+
+        /**
+         * Remainder of truncating division, has the sign of lhs
+         */
+        friend BigInteger operator%(const BigInteger &lhs, const BigInteger &rhs);
+
+        friend BigInteger operator-(const BigInteger &rhs);
+
+        /**
+         * Shifts magnitude, sign is kept
+         */
+        friend BigInteger operator<<(const BigInteger &lhs, std::size_t rhs);
+
+        /**
+         * Shifts magnitude, sign is kept: rounds toward zero like division by 2^rhs
+         */
+        friend BigInteger operator>>(const BigInteger &lhs, std::size_t rhs);
+
+        friend bool operator==(const BigInteger &lhs, const BigInteger &rhs) noexcept;
+
+        friend bool operator<(const BigInteger &lhs, const BigInteger &rhs) noexcept;
+
+        friend bool operator!=(const BigInteger &lhs, const BigInteger &rhs) noexcept {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator>(const BigInteger &lhs, const BigInteger &rhs) noexcept {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const BigInteger &lhs, const BigInteger &rhs) noexcept {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const BigInteger &lhs, const BigInteger &rhs) noexcept {
+            return !(lhs < rhs);
+        }
+
+        BigInteger &operator+=(const BigInteger &rhs) {
+            return *this = *this + rhs;
+        }
+
+        BigInteger &operator-=(const BigInteger &rhs) {
+            return *this = *this - rhs;
+        }
+
+        BigInteger &operator*=(const BigInteger &rhs) {
+            return *this = *this * rhs;
+        }
+
+        BigInteger &operator/=(const BigInteger &rhs) {
+            return *this = *this / rhs;
+        }
+
+        BigInteger &operator%=(const BigInteger &rhs) {
+            return *this = *this % rhs;
+        }
+
+        BigInteger &operator<<=(std::size_t rhs) {
+            return *this = *this << rhs;
+        }
+
+        BigInteger &operator>>=(std::size_t rhs) {
+            return *this = *this >> rhs;
+        }
+
+        BigInteger &operator++() {
+            return *this += BigInteger{1};
+        }
+
+        BigInteger &operator--() {
+            return *this -= BigInteger{1};
+        }
+
+        BigInteger operator++(int) {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        BigInteger operator--(int) {
+            auto result = *this;
+            --*this;
+            return result;
+        }
+
+        /**
+         * Number of significant bits of magnitude, found by utility::LehmerGcd through ADL
+         */
+        friend std::size_t BitWidth(const BigInteger &value) noexcept;
+
+        friend struct std::hash<BigInteger>;
+
+        friend std::string to_string(const BigInteger &value);
+
+        template<class _CharT, class _Traits>
+        friend std::basic_ostream<_CharT, _Traits> &
+        operator<<(std::basic_ostream<_CharT, _Traits> &os, const BigInteger &value) {
+            for (auto c : to_string(value)) {
+                os << os.widen(c);
+            }
+            return os;
+        }
+
+    private:
+        bool negative() const noexcept;
+
+        std::uint64_t InlineMagnitude() const noexcept;
+
+        Limbs Magnitude() const;
+
+        static Limbs ToLimbs(std::uint64_t magnitude);
+
+        static void Trim(Limbs &limbs) noexcept;
+
+        static int CompareMagnitude(const Limbs &lhs, const Limbs &rhs) noexcept;
+
+        static Limbs AddMagnitude(const Limbs &lhs, const Limbs &rhs);
+
+        static Limbs SubtractMagnitude(const Limbs &lhs, const Limbs &rhs);
+
+        static Limbs MultiplyMagnitude(const Limbs &lhs, const Limbs &rhs);
+
+        static void DivideMagnitude(const Limbs &lhs, const Limbs &rhs, Limbs &quotient, Limbs &remainder);
+
+        static BigInteger FromMagnitude(bool negative, Limbs magnitude);
+
+        static BigInteger AddSigned(bool lhs_negative, const Limbs &lhs, bool rhs_negative, const Limbs &rhs);
+
+        static void DivideSigned(const BigInteger &lhs, const BigInteger &rhs,
+                                 BigInteger *quotient, BigInteger *remainder);
+
+        std::int64_t small_{};
+        bool negative_{};
+        Limbs limbs_;
+    };
+
+    using big_fraction = Fractional<BigInteger, overflow::NoCheck>;
+NAMESPACE_FRACTIONAL_END
+
+namespace std {
+    /**
+     * Equal values have equal representations, so the representation is hashed
+     */
+    template<>
+    struct hash<fractional::BigInteger> {
+        std::size_t operator()(const fractional::BigInteger &value) const noexcept;
+    };
+
+    template<>
+    struct numeric_limits<fractional::BigInteger> {
+        static constexpr bool is_specialized = true;
+        static constexpr bool is_signed = true;
+        static constexpr bool is_integer = true;
+        static constexpr bool is_exact = true;
+        static constexpr bool has_infinity = false;
+        static constexpr bool has_quiet_NaN = false;
+        static constexpr bool has_signaling_NaN = false;
+        static constexpr float_denorm_style has_denorm = denorm_absent;
+        static constexpr bool has_denorm_loss = false;
+        static constexpr float_round_style round_style = round_toward_zero;
+        static constexpr bool is_iec559 = false;
+        static constexpr bool is_bounded = false;
+        static constexpr bool is_modulo = false;
+        static constexpr int digits = 0;
+        static constexpr int digits10 = 0;
+        static constexpr int max_digits10 = 0;
+        static constexpr int radix = 2;
+        static constexpr int min_exponent = 0;
+        static constexpr int min_exponent10 = 0;
+        static constexpr int max_exponent = 0;
+        static constexpr int max_exponent10 = 0;
+        static constexpr bool traps = false;
+        static constexpr bool tinyness_before = false;
+
+        static fractional::BigInteger min() noexcept { return {}; }
+
+        static fractional::BigInteger lowest() noexcept { return {}; }
+
+        static fractional::BigInteger max() noexcept { return {}; }
+
+        static fractional::BigInteger epsilon() noexcept { return {}; }
+
+        static fractional::BigInteger round_error() noexcept { return {}; }
+
+        static fractional::BigInteger infinity() noexcept { return {}; }
+
+        static fractional::BigInteger quiet_NaN() noexcept { return {}; }
+
+        static fractional::BigInteger signaling_NaN() noexcept { return {}; }
+
+        static fractional::BigInteger denorm_min() noexcept { return {}; }
+    };
+}
+
+#include "biginteger.hxx"
+
+#endif //FRACTIONNUMBER_BIGINTEGER_HPP
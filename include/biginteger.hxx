@@ -0,0 +1,459 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_BIGINTEGER_HXX
+#define FRACTIONNUMBER_BIGINTEGER_HXX
+
+#include <algorithm>
+#include <stdexcept>
+#include "biginteger.hpp"
+
+NAMESPACE_FRACTIONAL_BEGIN
+    template<class T, typename>
+    BigInteger::BigInteger(T value) {
+        if constexpr (std::is_signed_v<T> && sizeof(T) <= sizeof(std::int64_t)) {
+            small_ = value;
+        } else if constexpr (std::is_unsigned_v<T> && sizeof(T) < sizeof(std::int64_t)) {
+            small_ = std::int64_t(value);
+        } else {
+            using UType = std::make_unsigned_t<T>;
+            bool negative = false;
+            UType magnitude = UType(value);
+            if constexpr (std::is_signed_v<T>) {
+                if (value < 0) {
+                    negative = true;
+                    magnitude = UType(UType{} - magnitude);
+                }
+            }
+            Limbs limbs;
+            while (magnitude != 0) {
+                limbs.push_back(Limb(magnitude));
+                magnitude = UType(magnitude >> 16u >> 16u);
+            }
+            *this = FromMagnitude(negative, std::move(limbs));
+        }
+    }
+
+    template<class T, typename std::enable_if_t<std::is_integral_v<T>, int>>
+    BigInteger::operator T() const noexcept {
+        using UType = std::make_unsigned_t<T>;
+        if (is_inline()) {
+            return T(small_);
+        }
+        UType result{};
+        for (auto i = limbs_.size(); i-- > 0;) {
+            result = UType(UType(result << 16u << 16u) | limbs_[i]);
+        }
+        return T(negative_ ? UType(UType{} - result) : result);
+    }
+
+    template<class T, typename std::enable_if_t<std::is_floating_point_v<T>, int>>
+    BigInteger::operator T() const noexcept {
+        if (is_inline()) {
+            return T(small_);
+        }
+        T result{};
+        for (auto i = limbs_.size(); i-- > 0;) {
+            result = result * T(4294967296.0) + T(limbs_[i]);
+        }
+        return negative_ ? -result : result;
+    }
+
+    inline int BigInteger::sign() const noexcept {
+        if (is_inline()) {
+            return (small_ > 0) - (small_ < 0);
+        }
+        return negative_ ? -1 : 1;
+    }
+
+    inline bool BigInteger::negative() const noexcept {
+        return is_inline() ? small_ < 0 : negative_;
+    }
+
+    inline std::uint64_t BigInteger::InlineMagnitude() const noexcept {
+        return small_ < 0 ? std::uint64_t(0) - std::uint64_t(small_) : std::uint64_t(small_);
+    }
+
+    inline BigInteger::Limbs BigInteger::Magnitude() const {
+        return is_inline() ? ToLimbs(InlineMagnitude()) : limbs_;
+    }
+
+    inline BigInteger::Limbs BigInteger::ToLimbs(std::uint64_t magnitude) {
+        Limbs limbs;
+        if (magnitude != 0) {
+            limbs.push_back(Limb(magnitude));
+            if (magnitude >> 32u) {
+                limbs.push_back(Limb(magnitude >> 32u));
+            }
+        }
+        return limbs;
+    }
+
+    inline void BigInteger::Trim(Limbs &limbs) noexcept {
+        while (!limbs.empty() && limbs.back() == 0) {
+            limbs.pop_back();
+        }
+    }
+
+    inline int BigInteger::CompareMagnitude(const Limbs &lhs, const Limbs &rhs) noexcept {
+        if (lhs.size() != rhs.size()) {
+            return lhs.size() < rhs.size() ? -1 : 1;
+        }
+        for (auto i = lhs.size(); i-- > 0;) {
+            if (lhs[i] != rhs[i]) {
+                return lhs[i] < rhs[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    inline BigInteger::Limbs BigInteger::AddMagnitude(const Limbs &lhs, const Limbs &rhs) {
+        const auto &longer = lhs.size() < rhs.size() ? rhs : lhs;
+        const auto &shorter = lhs.size() < rhs.size() ? lhs : rhs;
+
+        Limbs result(longer.size() + 1);
+        std::uint64_t carry = 0;
+        for (std::size_t i = 0; i < longer.size(); ++i) {
+            carry += std::uint64_t(longer[i]) + (i < shorter.size() ? shorter[i] : 0);
+            result[i] = Limb(carry);
+            carry >>= 32u;
+        }
+        result.back() = Limb(carry);
+        Trim(result);
+        return result;
+    }
+
+    inline BigInteger::Limbs BigInteger::SubtractMagnitude(const Limbs &lhs, const Limbs &rhs) {
+        Limbs result(lhs.size());
+        std::int64_t borrow = 0;
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            borrow += std::int64_t(lhs[i]) - (i < rhs.size() ? std::int64_t(rhs[i]) : 0);
+            result[i] = Limb(borrow);
+            borrow >>= 32;
+        }
+        Trim(result);
+        return result;
+    }
+
+    inline BigInteger::Limbs BigInteger::MultiplyMagnitude(const Limbs &lhs, const Limbs &rhs) {
+        if (lhs.empty() || rhs.empty()) {
+            return {};
+        }
+        Limbs result(lhs.size() + rhs.size());
+        for (std::size_t i = 0; i < lhs.size(); ++i) {
+            std::uint64_t carry = 0;
+            for (std::size_t j = 0; j < rhs.size(); ++j) {
+                carry += std::uint64_t(lhs[i]) * rhs[j] + result[i + j];
+                result[i + j] = Limb(carry);
+                carry >>= 32u;
+            }
+            result[i + rhs.size()] = Limb(carry);
+        }
+        Trim(result);
+        return result;
+    }
+
+    /**
+     * Knuth's algorithm D, rhs must not be empty
+     */
+    inline void BigInteger::DivideMagnitude(const Limbs &lhs, const Limbs &rhs, Limbs &quotient, Limbs &remainder) {
+        constexpr std::uint64_t base = std::uint64_t(1) << 32u;
+
+        if (CompareMagnitude(lhs, rhs) < 0) {
+            quotient.clear();
+            remainder = lhs;
+            return;
+        }
+
+        auto m = lhs.size();
+        auto n = rhs.size();
+        quotient.assign(m - n + 1, 0);
+
+        if (n == 1) {
+            std::uint64_t rest = 0;
+            for (auto i = m; i-- > 0;) {
+                rest = (rest << 32u) | lhs[i];
+                quotient[i] = Limb(rest / rhs[0]);
+                rest %= rhs[0];
+            }
+            Trim(quotient);
+            remainder = ToLimbs(rest);
+            return;
+        }
+
+    /*
+     * Normalize so the top divisor limb has its high bit set
+     */
+        auto shift = unsigned(__builtin_clz(rhs[n - 1]));
+        Limbs v(n), u(m + 1);
+        for (auto i = n - 1; i > 0; --i) {
+            v[i] = Limb((std::uint64_t(rhs[i]) << shift) | (std::uint64_t(rhs[i - 1]) >> (32u - shift)));
+        }
+        v[0] = Limb(std::uint64_t(rhs[0]) << shift);
+        u[m] = Limb(std::uint64_t(lhs[m - 1]) >> (32u - shift));
+        for (auto i = m - 1; i > 0; --i) {
+            u[i] = Limb((std::uint64_t(lhs[i]) << shift) | (std::uint64_t(lhs[i - 1]) >> (32u - shift)));
+        }
+        u[0] = Limb(std::uint64_t(lhs[0]) << shift);
+
+        for (auto j = m - n + 1; j-- > 0;) {
+            auto numerator = (std::uint64_t(u[j + n]) << 32u) | u[j + n - 1];
+            auto qhat = numerator / v[n - 1];
+            auto rhat = numerator % v[n - 1];
+            while (qhat >= base || qhat * v[n - 2] > ((rhat << 32u) | u[j + n - 2])) {
+                --qhat;
+                rhat += v[n - 1];
+                if (rhat >= base)
+                    break;
+            }
+
+    /*
+     * Multiply and subtract qhat * v from u[j .. j + n]
+     */
+            std::int64_t borrow = 0;
+            std::int64_t t = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                auto product = qhat * v[i];
+                t = std::int64_t(u[i + j]) - borrow - std::int64_t(product & 0xFFFFFFFFu);
+                u[i + j] = Limb(t);
+                borrow = std::int64_t(product >> 32u) - (t >> 32);
+            }
+            t = std::int64_t(u[j + n]) - borrow;
+            u[j + n] = Limb(t);
+
+            quotient[j] = Limb(qhat);
+            if (t < 0) {
+    /*
+     * qhat was one too large, add v back
+     */
+                --quotient[j];
+                std::uint64_t carry = 0;
+                for (std::size_t i = 0; i < n; ++i) {
+                    carry += std::uint64_t(u[i + j]) + v[i];
+                    u[i + j] = Limb(carry);
+                    carry >>= 32u;
+                }
+                u[j + n] = Limb(u[j + n] + carry);
+            }
+        }
+
+        remainder.assign(n, 0);
+        for (std::size_t i = 0; i < n; ++i) {
+            remainder[i] = Limb((std::uint64_t(u[i]) >> shift) | (std::uint64_t(u[i + 1]) << (32u - shift)));
+        }
+        Trim(quotient);
+        Trim(remainder);
+    }
+
+    inline BigInteger BigInteger::FromMagnitude(bool negative, Limbs magnitude) {
+        Trim(magnitude);
+        BigInteger result;
+        if (magnitude.size() <= 2) {
+            std::uint64_t value = magnitude.empty() ? 0 : magnitude[0];
+            if (magnitude.size() == 2) {
+                value |= std::uint64_t(magnitude[1]) << 32u;
+            }
+            constexpr auto max = std::uint64_t(std::numeric_limits<std::int64_t>::max());
+            if (value <= max || (negative && value == max + 1)) {
+                result.small_ = negative ? std::int64_t(std::uint64_t(0) - value) : std::int64_t(value);
+                return result;
+            }
+        }
+        result.negative_ = negative;
+        result.limbs_ = std::move(magnitude);
+        return result;
+    }
+
+    inline BigInteger
+    BigInteger::AddSigned(bool lhs_negative, const Limbs &lhs, bool rhs_negative, const Limbs &rhs) {
+        if (lhs_negative == rhs_negative) {
+            return FromMagnitude(lhs_negative, AddMagnitude(lhs, rhs));
+        }
+        if (CompareMagnitude(lhs, rhs) >= 0) {
+            return FromMagnitude(lhs_negative, SubtractMagnitude(lhs, rhs));
+        }
+        return FromMagnitude(rhs_negative, SubtractMagnitude(rhs, lhs));
+    }
+
+    inline void BigInteger::DivideSigned(const BigInteger &lhs, const BigInteger &rhs,
+                                         BigInteger *quotient, BigInteger *remainder) {
+        if (rhs.sign() == 0) {
+            throw std::domain_error("BigInteger division by zero");
+        }
+        if (lhs.is_inline() && rhs.is_inline() &&
+            !(lhs.small_ == std::numeric_limits<std::int64_t>::lowest() && rhs.small_ == -1)) {
+            if (quotient)
+                *quotient = BigInteger{lhs.small_ / rhs.small_};
+            if (remainder)
+                *remainder = BigInteger{lhs.small_ % rhs.small_};
+            return;
+        }
+
+        Limbs q, r;
+        DivideMagnitude(lhs.Magnitude(), rhs.Magnitude(), q, r);
+        if (quotient)
+            *quotient = FromMagnitude(lhs.negative() != rhs.negative(), std::move(q));
+        if (remainder)
+            *remainder = FromMagnitude(lhs.negative(), std::move(r));
+    }
+
+    inline BigInteger operator+(const BigInteger &lhs, const BigInteger &rhs) {
+        std::int64_t result;
+        if (lhs.is_inline() && rhs.is_inline() && !__builtin_add_overflow(lhs.small_, rhs.small_, &result)) {
+            return BigInteger{result};
+        }
+        return BigInteger::AddSigned(lhs.negative(), lhs.Magnitude(), rhs.negative(), rhs.Magnitude());
+    }
+
+    inline BigInteger operator-(const BigInteger &lhs, const BigInteger &rhs) {
+        std::int64_t result;
+        if (lhs.is_inline() && rhs.is_inline() && !__builtin_sub_overflow(lhs.small_, rhs.small_, &result)) {
+            return BigInteger{result};
+        }
+        return BigInteger::AddSigned(lhs.negative(), lhs.Magnitude(), !rhs.negative(), rhs.Magnitude());
+    }
+
+    inline BigInteger operator*(const BigInteger &lhs, const BigInteger &rhs) {
+        std::int64_t result;
+        if (lhs.is_inline() && rhs.is_inline() && !__builtin_mul_overflow(lhs.small_, rhs.small_, &result)) {
+            return BigInteger{result};
+        }
+        return BigInteger::FromMagnitude(lhs.negative() != rhs.negative(),
+                                         BigInteger::MultiplyMagnitude(lhs.Magnitude(), rhs.Magnitude()));
+    }
+
+    inline BigInteger operator/(const BigInteger &lhs, const BigInteger &rhs) {
+        BigInteger quotient;
+        BigInteger::DivideSigned(lhs, rhs, &quotient, nullptr);
+        return quotient;
+    }
+
+    inline BigInteger operator%(const BigInteger &lhs, const BigInteger &rhs) {
+        BigInteger remainder;
+        BigInteger::DivideSigned(lhs, rhs, nullptr, &remainder);
+        return remainder;
+    }
+
+    inline BigInteger operator-(const BigInteger &rhs) {
+        if (rhs.is_inline() && rhs.small_ != std::numeric_limits<std::int64_t>::lowest()) {
+            return BigInteger{-rhs.small_};
+        }
+        return BigInteger::FromMagnitude(!rhs.negative(), rhs.Magnitude());
+    }
+
+    inline BigInteger operator<<(const BigInteger &lhs, std::size_t rhs) {
+        if (lhs.is_inline() && rhs < 63 && (lhs.InlineMagnitude() >> (62 - rhs)) == 0) {
+            return BigInteger{lhs.small_ < 0 ? -std::int64_t(lhs.InlineMagnitude() << rhs)
+                                             : std::int64_t(lhs.InlineMagnitude() << rhs)};
+        }
+        auto magnitude = lhs.Magnitude();
+        if (magnitude.empty()) {
+            return {};
+        }
+        auto limbs = rhs / 32;
+        auto bits = unsigned(rhs % 32);
+        BigInteger::Limbs result(magnitude.size() + limbs + 1);
+        for (std::size_t i = 0; i < magnitude.size(); ++i) {
+            auto shifted = std::uint64_t(magnitude[i]) << bits;
+            result[i + limbs] |= BigInteger::Limb(shifted);
+            result[i + limbs + 1] |= BigInteger::Limb(shifted >> 32u);
+        }
+        return BigInteger::FromMagnitude(lhs.negative(), std::move(result));
+    }
+
+    inline BigInteger operator>>(const BigInteger &lhs, std::size_t rhs) {
+        if (lhs.is_inline()) {
+            auto magnitude = rhs < 64 ? lhs.InlineMagnitude() >> rhs : 0;
+            return BigInteger::FromMagnitude(lhs.negative(), BigInteger::ToLimbs(magnitude));
+        }
+        auto limbs = rhs / 32;
+        auto bits = unsigned(rhs % 32);
+        if (limbs >= lhs.limbs_.size()) {
+            return {};
+        }
+        BigInteger::Limbs result(lhs.limbs_.size() - limbs);
+        for (std::size_t i = 0; i < result.size(); ++i) {
+            auto low = std::uint64_t(lhs.limbs_[i + limbs]) >> bits;
+            auto high = i + limbs + 1 < lhs.limbs_.size()
+                        ? std::uint64_t(lhs.limbs_[i + limbs + 1]) << (32u - bits) : 0;
+            result[i] = BigInteger::Limb(low | high);
+        }
+        return BigInteger::FromMagnitude(lhs.negative_, std::move(result));
+    }
+
+    inline bool operator==(const BigInteger &lhs, const BigInteger &rhs) noexcept {
+        if (lhs.is_inline() || rhs.is_inline()) {
+            return lhs.is_inline() && rhs.is_inline() && lhs.small_ == rhs.small_;
+        }
+        return lhs.negative_ == rhs.negative_ && lhs.limbs_ == rhs.limbs_;
+    }
+
+    inline bool operator<(const BigInteger &lhs, const BigInteger &rhs) noexcept {
+        if (lhs.is_inline() && rhs.is_inline()) {
+            return lhs.small_ < rhs.small_;
+        }
+        if (lhs.negative() != rhs.negative()) {
+            return lhs.negative();
+        }
+    /*
+     * Same sign and one of them is not inline, so it has the larger magnitude
+     */
+        if (lhs.is_inline() || rhs.is_inline()) {
+            return lhs.is_inline() != lhs.negative();
+        }
+        auto compare = BigInteger::CompareMagnitude(lhs.limbs_, rhs.limbs_);
+        return lhs.negative_ ? compare > 0 : compare < 0;
+    }
+
+    inline std::size_t BitWidth(const BigInteger &value) noexcept {
+        if (value.is_inline()) {
+            return utility::BitWidth(value.InlineMagnitude());
+        }
+        return (value.limbs_.size() - 1) * 32 + utility::BitWidth(value.limbs_.back());
+    }
+
+    inline std::string to_string(const BigInteger &value) {
+        if (value.is_inline()) {
+            return std::to_string(value.small_);
+        }
+
+    /*
+     * Peel off base 10^9 chunks from the magnitude
+     */
+        constexpr BigInteger::Limb chunk = 1000000000u;
+        auto magnitude = value.limbs_;
+        std::vector<BigInteger::Limb> chunks;
+        while (!magnitude.empty()) {
+            std::uint64_t rest = 0;
+            for (auto i = magnitude.size(); i-- > 0;) {
+                rest = (rest << 32u) | magnitude[i];
+                magnitude[i] = BigInteger::Limb(rest / chunk);
+                rest %= chunk;
+            }
+            BigInteger::Trim(magnitude);
+            chunks.push_back(BigInteger::Limb(rest));
+        }
+
+        std::string result = value.negative_ ? "-" : "";
+        result += std::to_string(chunks.back());
+        for (auto i = chunks.size() - 1; i-- > 0;) {
+            auto digits = std::to_string(chunks[i]);
+            result.append(9 - digits.size(), '0');
+            result += digits;
+        }
+        return result;
+    }
+NAMESPACE_FRACTIONAL_END
+
+inline std::size_t std::hash<fractional::BigInteger>::operator()(const fractional::BigInteger &value) const noexcept {
+    if (value.is_inline())
+        return std::size_t(fractional::MixHash(std::uint64_t(value.small_)));
+    auto hash = fractional::MixHash(value.negative_ ? ~std::uint64_t(value.limbs_.size()) : value.limbs_.size());
+    for (auto limb : value.limbs_) {
+        hash = fractional::MixHash(hash ^ limb);
+    }
+    return std::size_t(hash);
+}
+
+#endif //FRACTIONNUMBER_BIGINTEGER_HXX
@@ -0,0 +1,141 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_BLOCKCACHE_HPP
+#define FRACTIONNUMBER_BLOCKCACHE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+/**
+ * Per-thread caching of heap blocks for heap-backed NaturalType. Arithmetic on such types
+ * creates and destroys temporaries of a few recurring sizes; freed blocks are kept in the
+ * cache of the freeing thread and handed out again, so a steady-state workload stops calling
+ * operator new. Every block comes from operator new in power-of-two sizes and carries no
+ * owner, any thread may free it and values may outlive the thread that allocated them.
+ */
+namespace fractional::memory {
+    class BlockCache final : public std::pmr::memory_resource {
+    public:
+        static constexpr std::size_t MinBlock = 16;
+        static constexpr std::size_t MaxBlock = std::size_t(1) << 16u;
+
+        /**
+         * Cached bytes per block size, further freed blocks go back to operator delete
+         */
+        static constexpr std::size_t ClassCapacity = std::size_t(1) << 18u;
+
+        struct Statistics {
+            std::uint64_t allocations = 0;
+
+            /**
+             * Allocations served from the cache
+             */
+            std::uint64_t hits = 0;
+
+            /**
+             * Allocations that called operator new, including blocks too large to cache
+             */
+            std::uint64_t system = 0;
+        };
+
+        BlockCache() = default;
+
+        BlockCache(const BlockCache &) = delete;
+
+        BlockCache &operator=(const BlockCache &) = delete;
+
+        ~BlockCache() override;
+
+        /**
+         * Cache of the calling thread, nullptr while the thread is exiting and its cache is gone
+         */
+        static BlockCache *Local() noexcept;
+
+        /**
+         * Bytes actually allocated for a request of bytes with alignment
+         */
+        static constexpr std::size_t BlockSize(std::size_t bytes, std::size_t alignment) noexcept;
+
+        /**
+         * operator new of BlockSize(bytes, alignment), without a cache
+         */
+        static void *SystemAllocate(std::size_t bytes, std::size_t alignment);
+
+        static void SystemDeallocate(void *block, std::size_t, std::size_t alignment) noexcept;
+
+        Statistics statistics() const noexcept;
+
+        /**
+         * Returns every cached block to operator delete
+         */
+        void release() noexcept;
+
+    private:
+        static constexpr std::size_t Classes = 13;
+
+        struct LocalTag {
+        };
+
+        /**
+         * The cache of Local(), its destructor marks the thread as exiting
+         */
+        explicit BlockCache(LocalTag) noexcept : local_(true) {}
+
+        struct FreeBlock {
+            FreeBlock *next;
+        };
+
+        /**
+         * Size class of a cacheable request, Classes otherwise
+         */
+        static constexpr std::size_t Class(std::size_t bytes, std::size_t alignment) noexcept;
+
+        static bool &Exited() noexcept;
+
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+        void do_deallocate(void *block, std::size_t bytes, std::size_t alignment) override;
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+
+        std::array<FreeBlock *, Classes> free_{};
+        std::array<std::size_t, Classes> cached_{};
+        Statistics statistics_;
+        bool local_ = false;
+    };
+
+    /**
+     * Stateless allocator of BlockCache::Local(), falls back to operator new while the thread exits
+     */
+    template<class T>
+    struct CachingAllocator {
+        using value_type = T;
+
+        CachingAllocator() noexcept = default;
+
+        template<class U>
+        CachingAllocator(const CachingAllocator<U> &) noexcept {}
+
+        T *allocate(std::size_t size);
+
+        void deallocate(T *values, std::size_t size) noexcept;
+
+        template<class U>
+        bool operator==(const CachingAllocator<U> &) const noexcept {
+            return true;
+        }
+
+        template<class U>
+        bool operator!=(const CachingAllocator<U> &) const noexcept {
+            return false;
+        }
+    };
+}
+
+#include "blockcache.hxx"
+
+#endif //FRACTIONNUMBER_BLOCKCACHE_HPP
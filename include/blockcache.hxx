@@ -0,0 +1,127 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_BLOCKCACHE_HXX
+#define FRACTIONNUMBER_BLOCKCACHE_HXX
+
+#include <new>
+#include <typeinfo>
+#include "blockcache.hpp"
+#include "utility.hpp"
+
+namespace fractional::memory {
+    inline BlockCache::~BlockCache() {
+        release();
+        if (local_)
+            Exited() = true;
+    }
+
+    inline BlockCache *BlockCache::Local() noexcept {
+    /*
+     * The flag is trivially destructible, it can be read after the cache is destroyed
+     */
+        if (Exited())
+            return nullptr;
+        thread_local BlockCache cache{LocalTag{}};
+        return &cache;
+    }
+
+    inline bool &BlockCache::Exited() noexcept {
+        thread_local bool exited = false;
+        return exited;
+    }
+
+    constexpr std::size_t BlockCache::Class(std::size_t bytes, std::size_t alignment) noexcept {
+        if (bytes > MaxBlock || alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return Classes;
+        if (bytes <= MinBlock)
+            return 0;
+        return utility::BitWidth(bytes - 1) - utility::BitWidth(MinBlock - 1);
+    }
+
+    constexpr std::size_t BlockCache::BlockSize(std::size_t bytes, std::size_t alignment) noexcept {
+        auto size_class = Class(bytes, alignment);
+        return size_class == Classes ? bytes : MinBlock << size_class;
+    }
+
+    inline void *BlockCache::SystemAllocate(std::size_t bytes, std::size_t alignment) {
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return ::operator new(BlockSize(bytes, alignment), std::align_val_t(alignment));
+        return ::operator new(BlockSize(bytes, alignment));
+    }
+
+    inline void BlockCache::SystemDeallocate(void *block, std::size_t, std::size_t alignment) noexcept {
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(block, std::align_val_t(alignment));
+        } else {
+            ::operator delete(block);
+        }
+    }
+
+    inline BlockCache::Statistics BlockCache::statistics() const noexcept {
+        return statistics_;
+    }
+
+    inline void BlockCache::release() noexcept {
+        for (std::size_t size_class = 0; size_class < Classes; ++size_class) {
+            while (free_[size_class]) {
+                auto block = free_[size_class];
+                free_[size_class] = block->next;
+                ::operator delete(block);
+            }
+            cached_[size_class] = 0;
+        }
+    }
+
+    inline void *BlockCache::do_allocate(std::size_t bytes, std::size_t alignment) {
+        ++statistics_.allocations;
+        auto size_class = Class(bytes, alignment);
+        if (size_class < Classes && free_[size_class]) {
+            auto block = free_[size_class];
+            free_[size_class] = block->next;
+            cached_[size_class] -= MinBlock << size_class;
+            ++statistics_.hits;
+            return block;
+        }
+        ++statistics_.system;
+        return SystemAllocate(bytes, alignment);
+    }
+
+    inline void BlockCache::do_deallocate(void *block, std::size_t bytes, std::size_t alignment) {
+        auto size_class = Class(bytes, alignment);
+        if (size_class == Classes || cached_[size_class] + (MinBlock << size_class) > ClassCapacity) {
+            SystemDeallocate(block, bytes, alignment);
+            return;
+        }
+        free_[size_class] = ::new(block) FreeBlock{free_[size_class]};
+        cached_[size_class] += MinBlock << size_class;
+    }
+
+    /**
+     * Blocks of every BlockCache come from operator new, any of them may free a block of another
+     */
+    inline bool BlockCache::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+        return typeid(other) == typeid(BlockCache);
+    }
+
+    template<class T>
+    T *CachingAllocator<T>::allocate(std::size_t size) {
+        auto bytes = size * sizeof(T);
+        if (auto cache = BlockCache::Local())
+            return static_cast<T *>(cache->allocate(bytes, alignof(T)));
+        return static_cast<T *>(BlockCache::SystemAllocate(bytes, alignof(T)));
+    }
+
+    template<class T>
+    void CachingAllocator<T>::deallocate(T *values, std::size_t size) noexcept {
+        auto bytes = size * sizeof(T);
+        if (auto cache = BlockCache::Local()) {
+            cache->deallocate(values, bytes, alignof(T));
+        } else {
+            BlockCache::SystemDeallocate(values, bytes, alignof(T));
+        }
+    }
+}
+
+#endif //FRACTIONNUMBER_BLOCKCACHE_HXX
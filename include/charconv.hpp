@@ -0,0 +1,70 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_CHARCONV_HPP
+#define FRACTIONNUMBER_CHARCONV_HPP
+
+#include <charconv>
+#include <cstddef>
+#include <string_view>
+#include <system_error>
+#include <vector>
+#include "fractional.hpp"
+
+/**
+ * Locale-independent, non-allocating text conversion of Fractional with built-in NaturalType.
+ * Accepted input, an optional leading '-' applies to the whole value:
+ *  "a"       integer
+ *  "a/b"     fraction, b must not be zero
+ *  "a b/c"   mixed number, exactly one space between the whole and the fraction part
+ *  "a.ddd"   finite decimal, "a." and ".ddd" included, converted exactly
+ * Parsed values are reduced regardless of the Normalization policy.
+ * Errors follow std::from_chars: invalid_argument with ptr == first if there is no number,
+ * result_out_of_range with ptr past the number if its reduced value does not fit NaturalType.
+ */
+NAMESPACE_FRACTIONAL_BEGIN
+    template<class _Fract>
+    std::from_chars_result from_chars(const char *first, const char *last, _Fract &value);
+
+    /**
+     * Writes "n/d" like operator<<, value_too_large with ptr == last if [first, last) is too small
+     */
+    template<class _Fract>
+    std::to_chars_result to_chars(char *first, char *last, const _Fract &value);
+
+    struct ParseResult {
+        /**
+         * Number of fractions stored
+         */
+        std::size_t count;
+
+        /**
+         * First character not consumed
+         */
+        const char *ptr;
+
+        /**
+         * value_too_large if the output is full before the input ends
+         */
+        std::errc ec;
+    };
+
+    /**
+     * Parses fractions separated by any run of ',', ';', ' ', '\t', '\r', '\n' into out[0, capacity).
+     * A space followed by "b/c" is read as a mixed number, not as a separator.
+     * Stops at the first malformed or out of range number.
+     */
+    template<class _Fract>
+    ParseResult parse_fractions(std::string_view text, _Fract *out, std::size_t capacity);
+
+    /**
+     * Appends fractions parsed from text to out
+     */
+    template<class _Fract>
+    ParseResult parse_fractions(std::string_view text, std::vector<_Fract> &out);
+NAMESPACE_FRACTIONAL_END
+
+#include "charconv.hxx"
+
+#endif //FRACTIONNUMBER_CHARCONV_HPP
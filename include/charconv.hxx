@@ -0,0 +1,220 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_CHARCONV_HXX
+#define FRACTIONNUMBER_CHARCONV_HXX
+
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include "charconv.hpp"
+
+NAMESPACE_FRACTIONAL_BEGIN
+    namespace {
+        constexpr bool IsDigit(char c) noexcept {
+            return c >= '0' && c <= '9';
+        }
+
+        constexpr bool IsSeparator(char c) noexcept {
+            return c == ',' || c == ';' || c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        /**
+         * Reads a non-empty run of digits starting at ptr, ptr is moved past all of them
+         */
+        template<class _UType>
+        std::errc ParseMagnitude(const char *&ptr, const char *last, _UType &magnitude) noexcept {
+            auto [end, ec] = std::from_chars(ptr, last, magnitude);
+            ptr = end;
+            return ec;
+        }
+
+        /**
+         * Appends decimal digits to nominator, multiplying denominator by ten for each.
+         * Trailing zeros are skipped, they would only cancel out.
+         */
+        template<class _WideUnsigned>
+        std::errc ParseDecimals(const char *&ptr, const char *last, _WideUnsigned &nominator,
+                                _WideUnsigned &denominator) noexcept {
+            bool overflow = false;
+            std::size_t zeros = 0;
+            auto append = [&](unsigned digit) {
+                overflow |= __builtin_mul_overflow(nominator, _WideUnsigned(10), &nominator);
+                overflow |= __builtin_add_overflow(nominator, _WideUnsigned(digit), &nominator);
+                overflow |= __builtin_mul_overflow(denominator, _WideUnsigned(10), &denominator);
+            };
+
+            for (; ptr != last && IsDigit(*ptr); ++ptr) {
+                if (overflow)
+                    continue;
+                if (*ptr == '0') {
+                    ++zeros;
+                    continue;
+                }
+                for (; zeros > 0 && !overflow; --zeros) {
+                    append(0);
+                }
+                append(unsigned(*ptr - '0'));
+            }
+            return overflow ? std::errc::result_out_of_range : std::errc{};
+        }
+    }
+
+    template<class _Fract>
+    std::from_chars_result from_chars(const char *first, const char *last, _Fract &value) {
+        using NaturalType = typename _Fract::NaturalType;
+        static_assert(std::is_integral_v<NaturalType>, "from_chars requires built-in NaturalType");
+        using UType = std::make_unsigned_t<NaturalType>;
+        using WideType = std::make_unsigned_t<utility::WiderType<NaturalType>>;
+
+        auto ptr = first;
+        bool negative = ptr != last && *ptr == '-';
+        if (negative) {
+            if constexpr (std::is_unsigned_v<NaturalType>) {
+                return {first, std::errc::invalid_argument};
+            }
+            ++ptr;
+        }
+
+    /*
+     * Decimals are accumulated in double width, so a value is rejected only if it does not fit once reduced
+     */
+        WideType nominator{}, denominator = 1;
+        auto ec = std::errc{};
+        bool whole = ptr != last && IsDigit(*ptr);
+        bool matched = whole;
+        if (whole) {
+            UType whole_part{};
+            ec = ParseMagnitude(ptr, last, whole_part);
+            nominator = whole_part;
+        }
+
+        auto next = [&](std::size_t offset) {
+            return std::size_t(last - ptr) > offset ? ptr[offset] : '\0';
+        };
+        if (next(0) == '.' && (whole || IsDigit(next(1)))) {
+    /*
+     * Finite decimal: whole part followed by its fraction digits over a power of ten
+     */
+            ++ptr;
+            matched = true;
+            auto decimals_ec = ParseDecimals(ptr, last, nominator, denominator);
+            if (ec == std::errc{})
+                ec = decimals_ec;
+        } else if (whole && next(0) == '/' && IsDigit(next(1))) {
+            ++ptr;
+            UType magnitude{};
+            auto denominator_ec = ParseMagnitude(ptr, last, magnitude);
+            denominator = magnitude;
+            if (ec == std::errc{})
+                ec = denominator_ec;
+        } else if (whole && next(0) == ' ' && IsDigit(next(1))) {
+    /*
+     * Mixed number only if the part after the space is b/c, otherwise the space ends the number
+     */
+            auto part = ptr + 1;
+            UType part_nominator{}, part_denominator{};
+            auto part_ec = ParseMagnitude(part, last, part_nominator);
+            if (part != last && *part == '/' && part + 1 != last && IsDigit(part[1])) {
+                ++part;
+                auto denominator_ec = ParseMagnitude(part, last, part_denominator);
+                ptr = part;
+                if (ec == std::errc{})
+                    ec = part_ec != std::errc{} ? part_ec : denominator_ec;
+                if (ec == std::errc{}) {
+                    bool overflow = __builtin_mul_overflow(nominator, WideType(part_denominator), &nominator);
+                    overflow |= __builtin_add_overflow(nominator, WideType(part_nominator), &nominator);
+                    denominator = part_denominator;
+                    ec = overflow ? std::errc::result_out_of_range : std::errc{};
+                }
+            }
+        }
+
+        if (!matched)
+            return {first, std::errc::invalid_argument};
+        if (ec == std::errc{} && denominator == 0)
+            return {first, std::errc::invalid_argument};
+
+        constexpr auto max = WideType(std::numeric_limits<NaturalType>::max());
+        auto limit = negative ? WideType(max + 1) : max;
+        if (ec == std::errc{} && (nominator > limit || denominator > max)) {
+            auto gcd = std::gcd(nominator, denominator);
+            nominator /= gcd;
+            denominator /= gcd;
+            if (nominator > limit || denominator > max)
+                ec = std::errc::result_out_of_range;
+        }
+        if (ec != std::errc{})
+            return {ptr, ec};
+
+        auto n = negative ? NaturalType(UType(UType{} - UType(nominator))) : NaturalType(nominator);
+        auto d = NaturalType(denominator);
+        if constexpr (!_Fract::Normalization::IsCanonical) {
+            normalization::Reduce<_Fract>(n, d);
+        }
+        value = _Fract{n, d};
+        return {ptr, std::errc{}};
+    }
+
+    template<class _Fract>
+    std::to_chars_result to_chars(char *first, char *last, const _Fract &value) {
+        auto nominator = value.nominator();
+        auto denominator = value.denominator();
+        _Fract::Normalization::template OnRead<_Fract>(nominator, denominator);
+
+        auto result = std::to_chars(first, last, nominator);
+        if (result.ec != std::errc{} || result.ptr == last)
+            return {last, std::errc::value_too_large};
+        *result.ptr++ = '/';
+        result = std::to_chars(result.ptr, last, denominator);
+        if (result.ec != std::errc{})
+            return {last, std::errc::value_too_large};
+        return result;
+    }
+
+    template<class _Fract>
+    ParseResult parse_fractions(std::string_view text, _Fract *out, std::size_t capacity) {
+        auto ptr = text.data();
+        auto last = ptr + text.size();
+        std::size_t count = 0;
+        while (true) {
+            while (ptr != last && IsSeparator(*ptr)) {
+                ++ptr;
+            }
+            if (ptr == last)
+                return {count, ptr, std::errc{}};
+            if (count == capacity)
+                return {count, ptr, std::errc::value_too_large};
+
+            auto [end, ec] = from_chars(ptr, last, out[count]);
+            if (ec != std::errc{})
+                return {count, end, ec};
+            if (end != last && !IsSeparator(*end))
+                return {count, end, std::errc::invalid_argument};
+            ++count;
+            ptr = end;
+        }
+    }
+
+    template<class _Fract>
+    ParseResult parse_fractions(std::string_view text, std::vector<_Fract> &out) {
+        using NaturalType = typename _Fract::NaturalType;
+
+        auto ptr = text.data();
+        auto last = ptr + text.size();
+        std::size_t count = 0;
+        while (true) {
+            auto result = parse_fractions(std::string_view(ptr, std::size_t(last - ptr)),
+                                          &out.emplace_back(NaturalType{}, utility::One<NaturalType>()), 1);
+            if (result.count == 0)
+                out.pop_back();
+            count += result.count;
+            if (result.ec != std::errc::value_too_large)
+                return {count, result.ptr, result.ec};
+            ptr = result.ptr;
+        }
+    }
+NAMESPACE_FRACTIONAL_END
+
+#endif //FRACTIONNUMBER_CHARCONV_HXX
@@ -0,0 +1,220 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_FIXEDFRACTIONAL_HPP
+#define FRACTIONNUMBER_FIXEDFRACTIONAL_HPP
+
+#include <functional>
+#include <ostream>
+#include <type_traits>
+#include "fractional.hpp"
+
+/**
+ * Scaled integers: fractions whose denominator is a compile-time constant, such as cents
+ * (FixedFractional<long long, 100>) or audio ticks (FixedFractional<long long, 48000>).
+ * Only the nominator is stored, so a value is as large as NaturalType. Plus and minus are
+ * single checked integer operations without gcd or lcm. Multiply and divide round the
+ * rescaled result to the nearest multiple of 1/Denominator, ties away from zero.
+ * Results out of range of NaturalType are reported through the checker like those of plus
+ * and minus: throwing checkers throw overflow::OverflowBinaryError with the operands, the
+ * others keep the result wrapped modulo 2^digits and FlagOnCheck raises OverflowFlags::Multiply.
+ */
+NAMESPACE_FRACTIONAL_BEGIN
+    template<class _NaturalType, _NaturalType _Denominator,
+            template<class, template<class...> class, class...> class _OverflowChecker = overflow::ThrowOnCheck,
+            template<class...> class _IntegralChecker = overflow::IntegralCheckOverflow>
+    class FixedFractional {
+    public:
+        static_assert(std::is_integral_v<_NaturalType> && sizeof(_NaturalType) <= 8,
+                      "FixedFractional requires built-in NaturalType up to 64 bits");
+        static_assert(_Denominator > 0, "FixedFractional requires a positive denominator");
+
+        using NaturalType = _NaturalType;
+
+        using Checker = _OverflowChecker<_NaturalType, _IntegralChecker>;
+
+        using NothrowChecks = std::bool_constant<
+                noexcept(Checker::CheckPlus(declval<const NaturalType &>(), declval<const NaturalType &>())) &&
+                noexcept(Checker::CheckMinus(declval<const NaturalType &>(), declval<const NaturalType &>())) &&
+                noexcept(Checker::CheckMultiply(declval<const NaturalType &>(), declval<const NaturalType &>())) &&
+                noexcept(Checker::CheckDivide(declval<const NaturalType &>(), declval<const NaturalType &>())) &&
+                noexcept(Checker::CheckNegate(declval<const NaturalType &>()))>;
+
+        using PlusOperator = utility::OperatorWrapper<std::plus<NaturalType>, Checker::CheckPlus>;
+        using MinusOperator = utility::OperatorWrapper<std::minus<NaturalType>, Checker::CheckMinus>;
+        using MultiplyOperator = utility::OperatorWrapper<std::multiplies<NaturalType>, Checker::CheckMultiply>;
+        using NegateOperator = utility::OperatorWrapper<std::negate<NaturalType>, Checker::CheckNegate>;
+
+        static constexpr NaturalType Denominator = _Denominator;
+
+        /**
+         * True if the checker does not throw, then only the exact conversion from Fractional can
+         */
+        static constexpr bool IsNothrow = NothrowChecks::value;
+
+        constexpr FixedFractional() noexcept = delete;
+
+        /**
+         * The whole number integer, checked like a multiplication by Denominator
+         */
+        constexpr explicit FixedFractional(const NaturalType &integer) noexcept(IsNothrow);
+
+        /**
+         * Exact conversion, std::domain_error if value is not a multiple of 1/Denominator.
+         * A value out of range is reported through the checker.
+         */
+        template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS, typename = std::enable_if_t<
+                std::is_same_v<_NType, NaturalType>>>
+        constexpr explicit FixedFractional(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &value);
+
+        /**
+         * nominator/Denominator, no check and no normalization
+         */
+        static constexpr FixedFractional from_nominator(const NaturalType &nominator) noexcept;
+
+        /**
+         * Multiple of 1/Denominator nearest to value, ties away from zero
+         * @throw overflow::OverflowBinaryError from throwing checkers if it does not fit NaturalType
+         */
+        template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS, typename = std::enable_if_t<
+                std::is_same_v<_NType, NaturalType>>>
+        static constexpr FixedFractional nearest(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &value)
+        noexcept(IsNothrow);
+
+        constexpr const NaturalType &nominator() const noexcept {
+            return nominator_;
+        }
+
+        static constexpr NaturalType denominator() noexcept {
+            return Denominator;
+        }
+
+        /**
+         * The exact value as a Fractional of any policy with the same NaturalType, reduced by its constructor
+         */
+        template<class _Fract = Fractional<NaturalType>>
+        constexpr _Fract fraction() const;
+
+        template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS, typename = std::enable_if_t<
+                std::is_same_v<_NType, NaturalType>>>
+        constexpr operator Fractional<FRACTIONAL_TEMPLATE_PARAMS>() const {
+            return fraction<Fractional<FRACTIONAL_TEMPLATE_PARAMS>>();
+        }
+
+        /**
+         * Correctly rounded in the current rounding mode
+         */
+        template<class T, typename = std::enable_if_t<std::is_floating_point_v<T>>>
+        constexpr operator T() const noexcept;
+
+        constexpr FixedFractional &operator+=(const FixedFractional &rhs) noexcept(IsNothrow);
+
+        constexpr FixedFractional &operator-=(const FixedFractional &rhs) noexcept(IsNothrow);
+
+        /**
+         * Rounded product: the double-width product of the nominators divided by Denominator.
+         * For 64-bit NaturalType the division multiplies by a reciprocal of Denominator
+         * computed at compile time, narrower types leave that to the compiler.
+         * @throw overflow::OverflowBinaryError from throwing checkers if the result does not fit NaturalType
+         */
+        constexpr FixedFractional &operator*=(const FixedFractional &rhs) noexcept(IsNothrow);
+
+        /**
+         * Rounded quotient nominator * Denominator / rhs.nominator in double width. A zero divisor is
+         * reported by Checker::CheckDivide, checkers that do not throw leave the value unchanged.
+         * @throw like Checker::CheckDivide for a zero divisor, overflow::OverflowBinaryError from
+         * throwing checkers if the result does not fit NaturalType
+         */
+        constexpr FixedFractional &operator/=(const FixedFractional &rhs) noexcept(IsNothrow);
+
+        /**
+         * Exact scaling by an integer, a single checked multiplication
+         */
+        constexpr FixedFractional &operator*=(const NaturalType &rhs) noexcept(IsNothrow);
+
+    private:
+        struct NominatorTag {
+        };
+
+        constexpr FixedFractional(const NaturalType &nominator, NominatorTag) noexcept : nominator_(nominator) {}
+
+        NaturalType nominator_;
+    };
+
+#define DECLARATION_FIXED_TEMPLATE_PARAMS \
+class _FixedType, _FixedType _Denominator,\
+template<class, template<class...> class, class...> class _FixedOverflowChecker,\
+template<class...> class _FixedChecker
+
+#define FIXED_TEMPLATE_PARAMS _FixedType, _Denominator, _FixedOverflowChecker, _FixedChecker
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS>
+    operator+(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs, const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs)
+    noexcept(FixedFractional<FIXED_TEMPLATE_PARAMS>::IsNothrow);
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS>
+    operator-(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs, const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs)
+    noexcept(FixedFractional<FIXED_TEMPLATE_PARAMS>::IsNothrow);
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS>
+    operator*(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs, const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs)
+    noexcept(FixedFractional<FIXED_TEMPLATE_PARAMS>::IsNothrow);
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS>
+    operator*(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs, const _FixedType &rhs)
+    noexcept(FixedFractional<FIXED_TEMPLATE_PARAMS>::IsNothrow);
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS>
+    operator*(const _FixedType &lhs, const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs)
+    noexcept(FixedFractional<FIXED_TEMPLATE_PARAMS>::IsNothrow);
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS>
+    operator/(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs, const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs)
+    noexcept(FixedFractional<FIXED_TEMPLATE_PARAMS>::IsNothrow);
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS>
+    operator-(const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs)
+    noexcept(FixedFractional<FIXED_TEMPLATE_PARAMS>::IsNothrow);
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr bool operator==(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs,
+                              const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs) noexcept;
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr bool operator!=(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs,
+                              const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs) noexcept;
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr bool operator<(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs,
+                             const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs) noexcept;
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr bool operator<=(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs,
+                              const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs) noexcept;
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr bool operator>(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs,
+                             const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs) noexcept;
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr bool operator>=(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs,
+                              const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs) noexcept;
+
+    /**
+     * Writes the reduced value like Fractional
+     */
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    std::ostream &operator<<(std::ostream &os, const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs);
+NAMESPACE_FRACTIONAL_END
+
+#include "fixedfractional.hxx"
+
+#endif //FRACTIONNUMBER_FIXEDFRACTIONAL_HPP
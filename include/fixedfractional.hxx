@@ -0,0 +1,340 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_FIXEDFRACTIONAL_HXX
+#define FRACTIONNUMBER_FIXEDFRACTIONAL_HXX
+
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include "fixedfractional.hpp"
+
+NAMESPACE_FRACTIONAL_BEGIN
+    namespace {
+        /**
+         * Unsigned type holding the product of two magnitudes of _NaturalType
+         */
+        template<class _NaturalType>
+        using WideMagnitude = std::make_unsigned_t<utility::WiderType<_NaturalType>>;
+
+        /**
+         * Stores -magnitude if negative, magnitude otherwise, wrapped modulo 2^digits like built-in arithmetic
+         * @return false if the value does not fit _NaturalType
+         */
+        template<class _NaturalType, class _WideUnsigned>
+        constexpr bool Narrow(bool negative, const _WideUnsigned &magnitude, _NaturalType &result) noexcept {
+            using UType = std::make_unsigned_t<_NaturalType>;
+            constexpr auto max = _WideUnsigned(std::numeric_limits<_NaturalType>::max());
+            result = _NaturalType(negative ? UType(UType{} - UType(magnitude)) : UType(magnitude));
+            if (magnitude > max + _WideUnsigned(negative && std::is_signed_v<_NaturalType>))
+                return false;
+            return !negative || std::is_signed_v<_NaturalType> || magnitude == 0;
+        }
+
+        /**
+         * Reports a result of lhs and rhs out of range of _NaturalType. Throwing checkers get
+         * overflow::OverflowBinaryError, the others a product that overflows for sure, so FlagOnCheck
+         * raises OverflowFlags::Multiply.
+         */
+        template<class _Checker, class _NaturalType>
+        constexpr void ReportNarrowing(const _NaturalType &lhs, const _NaturalType &rhs)
+        noexcept(noexcept(_Checker::CheckMultiply(lhs, rhs))) {
+            if constexpr (noexcept(_Checker::CheckMultiply(lhs, rhs))) {
+                _Checker::CheckMultiply(std::numeric_limits<_NaturalType>::max(), _NaturalType(2));
+            } else {
+                throw overflow::OverflowBinaryError<_NaturalType, _NaturalType>(lhs, rhs);
+            }
+        }
+
+        /**
+         * dividend / divisor rounded half away from zero, divisor > 0
+         */
+        template<class _WideUnsigned>
+        constexpr _WideUnsigned RoundedQuotient(const _WideUnsigned &dividend, const _WideUnsigned &divisor) noexcept {
+            auto remainder = dividend % divisor;
+            return dividend / divisor + _WideUnsigned(remainder >= divisor - remainder);
+        }
+
+        /**
+         * Division of 128-bit values by the constant _Divisor with a reciprocal computed at compile time:
+         * two multiplications instead of a 128-bit division (Moller, Granlund, "Improved division by
+         * invariant integers", 2011).
+         */
+        template<unsigned long long _Divisor>
+        struct InvariantDivision {
+            using UType = unsigned long long;
+            using WideType = unsigned __int128;
+
+            static constexpr unsigned Shift = unsigned(64 - utility::BitWidth(_Divisor));
+            static constexpr UType Normalized = _Divisor << Shift;
+
+            /**
+             * floor((2^128 - 1) / Normalized) - 2^64
+             */
+            static constexpr UType Reciprocal = UType(~WideType{} / Normalized);
+
+            /**
+             * Quotient and remainder of value / _Divisor, the quotient must fit 64 bits
+             */
+            static constexpr std::pair<UType, UType> Divide(WideType value) noexcept {
+                value <<= Shift;
+                auto high = UType(value >> 64u);
+                auto low = UType(value);
+                auto estimate = WideType(Reciprocal) * high + (WideType(high + 1) << 64u) + low;
+                auto quotient = UType(estimate >> 64u);
+                auto remainder = UType(low - quotient * Normalized);
+            /*
+             * The estimate is at most one too large and, rarely, one too small
+             */
+                if (remainder > UType(estimate)) {
+                    --quotient;
+                    remainder += Normalized;
+                }
+                if (remainder >= Normalized) {
+                    ++quotient;
+                    remainder -= Normalized;
+                }
+                return {quotient, remainder >> Shift};
+            }
+        };
+
+        /**
+         * lhs * rhs / _Denominator rounded half away from zero, stored wrapped if it does not fit
+         * @return false if the result does not fit _NaturalType
+         */
+        template<class _NaturalType, _NaturalType _Denominator>
+        constexpr bool RescaledProduct(const _NaturalType &lhs, const _NaturalType &rhs,
+                                       _NaturalType &result) noexcept {
+            using WideType = WideMagnitude<_NaturalType>;
+
+            auto product = WideType(Magnitude(lhs)) * Magnitude(rhs);
+            bool negative = IsNegative(lhs) != IsNegative(rhs);
+            if constexpr (sizeof(_NaturalType) == 8) {
+                using Division = InvariantDivision<(unsigned long long) _Denominator>;
+                if ((product >> 64u) >= WideType(_Denominator))
+                    return Narrow(negative, RoundedQuotient(product, WideType(_Denominator)), result);
+                auto [quotient, remainder] = Division::Divide(product);
+                auto denominator = (unsigned long long) _Denominator;
+                return Narrow(negative, WideType(quotient) + (remainder >= denominator - remainder), result);
+            } else {
+                return Narrow(negative, RoundedQuotient(product, WideType(_Denominator)), result);
+            }
+        }
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS>::FixedFractional(const NaturalType &integer)
+    noexcept(IsNothrow) : nominator_(MultiplyOperator{}(integer, Denominator)) {}
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS, typename>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS>::FixedFractional(
+            const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &value) : nominator_() {
+        using UType = std::make_unsigned_t<NaturalType>;
+
+        Checker::CheckDivide(value.nominator(), value.denominator());
+        auto nominator = Magnitude(value.nominator());
+        auto denominator = Magnitude(value.denominator());
+        if (denominator == 0)
+            denominator = 1;
+        auto gcd = std::gcd(nominator, denominator);
+        if (UType(Denominator) % (denominator / gcd) != 0)
+            throw std::domain_error("value is not a multiple of 1/Denominator");
+
+        auto negative = IsNegative(value.nominator()) != IsNegative(value.denominator());
+        auto scaled = WideMagnitude<NaturalType>(nominator / gcd) * (UType(Denominator) / (denominator / gcd));
+        if (!Narrow(negative, scaled, nominator_))
+            ReportNarrowing<Checker>(value.nominator(), value.denominator());
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS>
+    FixedFractional<FIXED_TEMPLATE_PARAMS>::from_nominator(const NaturalType &nominator) noexcept {
+        return FixedFractional{nominator, NominatorTag{}};
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS, typename>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS>
+    FixedFractional<FIXED_TEMPLATE_PARAMS>::nearest(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &value)
+    noexcept(IsNothrow) {
+        using WideType = WideMagnitude<NaturalType>;
+
+        Checker::CheckDivide(value.nominator(), value.denominator());
+        auto negative = IsNegative(value.nominator()) != IsNegative(value.denominator());
+        auto denominator = Magnitude(value.denominator());
+        if (denominator == 0)
+            denominator = 1;
+        auto scaled = RoundedQuotient(WideType(Magnitude(value.nominator())) * Magnitude(Denominator),
+                                      WideType(denominator));
+        NaturalType nominator{};
+        if (!Narrow(negative, scaled, nominator))
+            ReportNarrowing<Checker>(value.nominator(), value.denominator());
+        return from_nominator(nominator);
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    template<class _Fract>
+    constexpr _Fract FixedFractional<FIXED_TEMPLATE_PARAMS>::fraction() const {
+        return _Fract{nominator_, Denominator};
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    template<class T, typename>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS>::operator T() const noexcept {
+        return ToFloating<T>(nominator_, Denominator);
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS> &
+    FixedFractional<FIXED_TEMPLATE_PARAMS>::operator+=(const FixedFractional &rhs) noexcept(IsNothrow) {
+        nominator_ = PlusOperator{}(nominator_, rhs.nominator_);
+        return *this;
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS> &
+    FixedFractional<FIXED_TEMPLATE_PARAMS>::operator-=(const FixedFractional &rhs) noexcept(IsNothrow) {
+        nominator_ = MinusOperator{}(nominator_, rhs.nominator_);
+        return *this;
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS> &
+    FixedFractional<FIXED_TEMPLATE_PARAMS>::operator*=(const FixedFractional &rhs) noexcept(IsNothrow) {
+        NaturalType result{};
+        if (!RescaledProduct<NaturalType, Denominator>(nominator_, rhs.nominator_, result))
+            ReportNarrowing<Checker>(nominator_, rhs.nominator_);
+        nominator_ = result;
+        return *this;
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS> &
+    FixedFractional<FIXED_TEMPLATE_PARAMS>::operator/=(const FixedFractional &rhs) noexcept(IsNothrow) {
+        using WideType = WideMagnitude<NaturalType>;
+
+    /*
+     * Checkers that do not throw report a zero divisor and go on dividing by one
+     */
+        Checker::CheckDivide(nominator_, rhs.nominator_);
+        auto negative = IsNegative(nominator_) != IsNegative(rhs.nominator_);
+        auto divisor = Magnitude(rhs.nominator_);
+        if (divisor == 0)
+            divisor = Magnitude(Denominator);
+        auto scaled = RoundedQuotient(WideType(Magnitude(nominator_)) * Magnitude(Denominator), WideType(divisor));
+        NaturalType result{};
+        if (!Narrow(negative, scaled, result))
+            ReportNarrowing<Checker>(nominator_, rhs.nominator_);
+        nominator_ = result;
+        return *this;
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS> &
+    FixedFractional<FIXED_TEMPLATE_PARAMS>::operator*=(const NaturalType &rhs) noexcept(IsNothrow) {
+        nominator_ = MultiplyOperator{}(nominator_, rhs);
+        return *this;
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS>
+    operator+(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs, const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs)
+    noexcept(FixedFractional<FIXED_TEMPLATE_PARAMS>::IsNothrow) {
+        auto result = lhs;
+        return result += rhs;
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS>
+    operator-(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs, const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs)
+    noexcept(FixedFractional<FIXED_TEMPLATE_PARAMS>::IsNothrow) {
+        auto result = lhs;
+        return result -= rhs;
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS>
+    operator*(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs, const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs)
+    noexcept(FixedFractional<FIXED_TEMPLATE_PARAMS>::IsNothrow) {
+        auto result = lhs;
+        return result *= rhs;
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS>
+    operator*(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs, const _FixedType &rhs)
+    noexcept(FixedFractional<FIXED_TEMPLATE_PARAMS>::IsNothrow) {
+        auto result = lhs;
+        return result *= rhs;
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS>
+    operator*(const _FixedType &lhs, const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs)
+    noexcept(FixedFractional<FIXED_TEMPLATE_PARAMS>::IsNothrow) {
+        auto result = rhs;
+        return result *= lhs;
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS>
+    operator/(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs, const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs)
+    noexcept(FixedFractional<FIXED_TEMPLATE_PARAMS>::IsNothrow) {
+        auto result = lhs;
+        return result /= rhs;
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr FixedFractional<FIXED_TEMPLATE_PARAMS>
+    operator-(const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs)
+    noexcept(FixedFractional<FIXED_TEMPLATE_PARAMS>::IsNothrow) {
+        using Fixed = FixedFractional<FIXED_TEMPLATE_PARAMS>;
+        return Fixed::from_nominator(typename Fixed::NegateOperator{}(rhs.nominator()));
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr bool operator==(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs,
+                              const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs) noexcept {
+        return lhs.nominator() == rhs.nominator();
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr bool operator!=(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs,
+                              const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs) noexcept {
+        return lhs.nominator() != rhs.nominator();
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr bool operator<(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs,
+                             const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs) noexcept {
+        return lhs.nominator() < rhs.nominator();
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr bool operator<=(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs,
+                              const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs) noexcept {
+        return lhs.nominator() <= rhs.nominator();
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr bool operator>(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs,
+                             const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs) noexcept {
+        return lhs.nominator() > rhs.nominator();
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    constexpr bool operator>=(const FixedFractional<FIXED_TEMPLATE_PARAMS> &lhs,
+                              const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs) noexcept {
+        return lhs.nominator() >= rhs.nominator();
+    }
+
+    template<DECLARATION_FIXED_TEMPLATE_PARAMS>
+    std::ostream &operator<<(std::ostream &os, const FixedFractional<FIXED_TEMPLATE_PARAMS> &rhs) {
+        return os << rhs.template fraction<Fractional<_FixedType, overflow::NoCheck>>();
+    }
+NAMESPACE_FRACTIONAL_END
+
+#endif //FRACTIONNUMBER_FIXEDFRACTIONAL_HXX
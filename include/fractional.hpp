@@ -8,17 +8,40 @@
 #define NAMESPACE_FRACTIONAL_BEGIN namespace fractional {
 #define NAMESPACE_FRACTIONAL_END }
 
+#define DECLARATION_FRACTIONAL_TEMPLATE_PARAMS \
+class _NType,\
+template<class, template<class...> class, class...> class _Checker,\
+template<class...> class _Checker_,\
+class _Normalization,\
+DECLARATION_TEMPLATE_PARAMS
+
+#define FRACTIONAL_TEMPLATE_PARAMS \
+_NType,\
+_Checker,\
+_Checker_,\
+_Normalization,\
+TEMPLATE_PARAMS
+
+#include <cassert>
+#include <optional>
+#include <utility>
 #include <type_traits>
 #include <functional>
+#include <limits>
 #include "overflowchecker.hpp"
+#include "normalization.hpp"
 #include "utility.hpp"
 
 NAMESPACE_FRACTIONAL_BEGIN
     using std::declval;
 
+    template<class _Fract>
+    class AtomicFractional;
+
     template<class _NaturalType,
             template<class, template<class...> class, class...> class _OverflowChecker = overflow::ThrowOnCheck,
             template<class...> class _Checker = overflow::IntegralCheckOverflow,
+            class _Normalization = normalization::Eager,
             class _EqualOperator = std::equal_to<_NaturalType>,
             class _NoEqualOperator = std::not_equal_to<_NaturalType>,
             class _GreaterOperator = std::greater<_NaturalType>,
@@ -37,6 +60,21 @@ NAMESPACE_FRACTIONAL_BEGIN
 
         using Checker = _OverflowChecker<_NaturalType, _Checker, TEMPLATE_PARAMS>;
 
+        using Normalization = _Normalization;
+
+        /**
+         * True if every check of Checker is noexcept. A member type is instantiated with Fractional,
+         * so dependent noexcept of checks is resolved before the operators below take their address:
+         * GCC 12 crashes on the opposite order.
+         */
+        using NothrowChecks = std::bool_constant<
+                noexcept(Checker::CheckPlus(declval<const NaturalType &>(), declval<const NaturalType &>())) &&
+                noexcept(Checker::CheckMinus(declval<const NaturalType &>(), declval<const NaturalType &>())) &&
+                noexcept(Checker::CheckMultiply(declval<const NaturalType &>(), declval<const NaturalType &>())) &&
+                noexcept(Checker::CheckDivide(declval<const NaturalType &>(), declval<const NaturalType &>())) &&
+                noexcept(Checker::CheckModulus(declval<const NaturalType &>(), declval<const NaturalType &>())) &&
+                noexcept(Checker::CheckNegate(declval<const NaturalType &>()))>;
+
         using PlusOperator = utility::OperatorWrapper<_PlusOperator, Checker::CheckPlus>;
         using MinusOperator = utility::OperatorWrapper<_MinusOperator, Checker::CheckMinus>;
         using MultiplyOperator = utility::OperatorWrapper<_MultiplyOperator, Checker::CheckMultiply>;
@@ -51,6 +89,12 @@ NAMESPACE_FRACTIONAL_BEGIN
         using LessOperator = _LessOperator;
         using LessEqualOperator = _LessEqualOperator;
 
+        /**
+         * True if construction and arithmetic cannot throw: NaturalType is built-in and
+         * Checker reports overflow without exceptions, like NoCheck and FlagOnCheck
+         */
+        static constexpr bool IsNothrow = std::is_integral_v<NaturalType> && NothrowChecks::value;
+
         constexpr Fractional() noexcept = delete;
 
         constexpr Fractional(
@@ -65,42 +109,220 @@ NAMESPACE_FRACTIONAL_BEGIN
         operator=(Fractional &&) noexcept(std::is_nothrow_move_assignable<NaturalType>::value) = default;
 
         constexpr Fractional(const NaturalType &nominator,
-                             const NaturalType &denominator)
+                             const NaturalType &denominator) noexcept(IsNothrow)
                 : nominator_(nominator), denominator_(denominator) {
             Checker::CheckDivide(nominator_, denominator_);
+            Normalization::template OnResult<Fractional>(nominator_, denominator_);
         }
 
         constexpr Fractional(NaturalType &&nominator,
-                             NaturalType &&denominator)
-                : nominator_(nominator), denominator_(denominator) {
+                             NaturalType &&denominator) noexcept(IsNothrow)
+                : nominator_(std::move(nominator)), denominator_(std::move(denominator)) {
             Checker::CheckDivide(nominator_, denominator_);
+            Normalization::template OnResult<Fractional>(nominator_, denominator_);
         }
 
+        /**
+         * Correctly rounded in the current rounding mode for built-in NaturalType,
+         * nominator and denominator that are exact in T are divided directly
+         */
         template<class T, typename = typename std::enable_if<
                 std::is_floating_point<T>::value &&
                 std::is_convertible<NaturalType, T>::value
         >::type>
-        operator T() {
-            Checker::CheckDivide(nominator_, denominator_);
-            return std::divides<T>{}(nominator_, denominator_);
-        }
+        constexpr operator T() const noexcept(std::is_integral_v<NaturalType>);
 
-        const NaturalType &nominator() const noexcept {
+        constexpr const NaturalType &nominator() const noexcept {
             return nominator_;
         }
 
-        const NaturalType &denominator() const noexcept {
+        constexpr const NaturalType &denominator() const noexcept {
             return denominator_;
         }
 
+        /**
+         * Brings value to canonical form regardless of Normalization policy
+         */
+        constexpr Fractional &reduce() noexcept(IsNothrow) {
+            normalization::Reduce<Fractional>(nominator_, denominator_);
+            return *this;
+        }
+
+        /**
+         * Closest fraction to finite x with denominator at most max_denominator > 0: the last convergent
+         * of the continued fraction of the exact binary value of x within bounds, or a semiconvergent.
+         * Exact for dyadic x that fits, saturates at the NaturalType range. Built-in NaturalType only.
+         */
+        static Fractional approximate(double x, const NaturalType &max_denominator) noexcept;
+
+        /**
+         * Fraction with the smallest denominator within tolerance of finite x,
+         * approximate(x, max_denominator) if no denominator up to max_denominator is close enough
+         */
+        static Fractional approximate_within(double x, double tolerance,
+                                             const NaturalType &max_denominator =
+                                             std::numeric_limits<NaturalType>::max()) noexcept;
+
+        /**
+         * In-place a/b += c/d, no temporary Fractional is built
+         */
+        constexpr Fractional &operator+=(const Fractional &rhs) noexcept(IsNothrow);
+
+        /**
+         * In-place a/b -= c/d, no temporary Fractional is built
+         */
+        constexpr Fractional &operator-=(const Fractional &rhs) noexcept(IsNothrow);
+
+        /**
+         * In-place a/b *= c/d, cross-cancels gcd(a, d) and gcd(c, b) before multiplying
+         */
+        constexpr Fractional &operator*=(const Fractional &rhs) noexcept(IsNothrow);
+
+        /**
+         * In-place a/b /= c/d, cross-cancels gcd(a, c) and gcd(d, b) before multiplying
+         */
+        constexpr Fractional &operator/=(const Fractional &rhs) noexcept(IsNothrow);
+
     private:
+        template<class _Fract>
+        friend class AtomicFractional;
+
+        struct CanonicalTag {
+        };
+
+        /**
+         * Stores nominator/denominator that is already canonical, no checks and no normalization
+         */
+        constexpr Fractional(const NaturalType &nominator, const NaturalType &denominator, CanonicalTag)
+        noexcept(std::is_nothrow_copy_constructible<NaturalType>::value)
+                : nominator_(nominator), denominator_(denominator) {}
+
+        /**
+         * Shared body of += and -=, _Operator is PlusOperator or MinusOperator
+         */
+        template<class _Operator>
+        constexpr void Accumulate(const Fractional &rhs) noexcept(IsNothrow);
+
+        /**
+         * Stores (lhs_n / lhs_g * rhs_n / rhs_g) / (lhs_d / rhs_g * rhs_d / lhs_g)
+         */
+        constexpr void CrossMultiply(const NaturalType &lhs_n, const NaturalType &lhs_d,
+                                     const NaturalType &rhs_n, const NaturalType &rhs_d) noexcept(IsNothrow);
+
+        /**
+         * Widening mode: reduces n/d in Checker::WideType and narrows it into this value
+         */
+        template<class _WideType>
+        constexpr void AssignWide(_WideType nominator, _WideType denominator);
+
         NaturalType nominator_;
         NaturalType denominator_;
     };
 
     using fraction = Fractional<int>;
+
+    /**
+     * Result of try_* arithmetic: the value, or the OverflowFlags raised while computing it.
+     * Neither allocates nor throws.
+     */
+    template<class _Fract>
+    class Expected {
+    public:
+        using ValueType = _Fract;
+        using ErrorType = overflow::OverflowFlags::Type;
+
+        constexpr Expected(const ValueType &value) noexcept(std::is_nothrow_copy_constructible_v<ValueType>)
+                : value_(value) {}
+
+        constexpr explicit Expected(ErrorType error) noexcept : error_(error) {}
+
+        constexpr bool has_value() const noexcept {
+            return value_.has_value();
+        }
+
+        constexpr explicit operator bool() const noexcept {
+            return has_value();
+        }
+
+        /**
+         * Must not be called without a value
+         */
+        constexpr const ValueType &value() const noexcept {
+            assert(has_value());
+            return *value_;
+        }
+
+        constexpr const ValueType &operator*() const noexcept {
+            return value();
+        }
+
+        constexpr const ValueType *operator->() const noexcept {
+            return &value();
+        }
+
+        constexpr ValueType value_or(const ValueType &fallback) const {
+            return has_value() ? *value_ : fallback;
+        }
+
+        /**
+         * @return raised OverflowFlags, OverflowFlags::None with a value
+         */
+        constexpr ErrorType error() const noexcept {
+            return error_;
+        }
+
+    private:
+        std::optional<ValueType> value_;
+        ErrorType error_ = overflow::OverflowFlags::None;
+    };
+
+    /**
+     * lhs + rhs computed with FlagOnCheck, built-in NaturalType only.
+     * The thread OverflowStatus is left as it was, overflow is reported through the result.
+     * Fractions of other checkers are converted to the FlagOnCheck twin and back, which costs a reduction.
+     */
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    Expected<Fractional<FRACTIONAL_TEMPLATE_PARAMS>>
+    try_add(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+            const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs) noexcept;
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    Expected<Fractional<FRACTIONAL_TEMPLATE_PARAMS>>
+    try_sub(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+            const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs) noexcept;
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    Expected<Fractional<FRACTIONAL_TEMPLATE_PARAMS>>
+    try_mul(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+            const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs) noexcept;
+
+    /**
+     * out[i] = double(first[i]) for every i in [0, last - first), vectorizable when
+     * NaturalType fits the double mantissa; other values are checked and fixed up after
+     */
+    template<class _Fract>
+    void to_double(const _Fract *first, const _Fract *last, double *out) noexcept;
+
+    /**
+     * out[i] = _Fract::approximate(first[i], max_denominator) for every i in [0, last - first)
+     */
+    template<class _Fract>
+    void approximate(const double *first, const double *last, _Fract *out,
+                     const typename _Fract::NaturalType &max_denominator) noexcept;
 NAMESPACE_FRACTIONAL_END
 
+namespace std {
+    /**
+     * Hash of the value: equal rationals such as 2/4 and 1/2 hash equal under every Normalization.
+     * Non-canonical values are reduced on a copy first. NaturalType other than built-in integers
+     * needs its own std::hash.
+     */
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    struct hash<fractional::Fractional<FRACTIONAL_TEMPLATE_PARAMS>> {
+        std::size_t operator()(const fractional::Fractional<FRACTIONAL_TEMPLATE_PARAMS> &value) const;
+    };
+}
+
 #include "fractional.hxx"
 
 #endif //FRACTIONNUMBER_FRACTIONAL_HPP
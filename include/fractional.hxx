@@ -5,160 +5,1021 @@
 #ifndef FRACTIONNUMBER_FRACTIONAL_HXX
 #define FRACTIONNUMBER_FRACTIONAL_HXX
 
+#include <algorithm>
+#include <cmath>
 #include <numeric>
+#include <utility>
 #include "utility.hpp"
 
 using std::declval;
 using namespace fractional;
 
-/**
- * @param lhs = a/b
- * @param rhs = c/d
- * @return Simplified a/b + c/d -> (a * b/lcm + c * d/lcm)/lcm
- */
-template<class _NType, template<class, template<class...> class, class...> class _Checker,
-        template<class...> class _Checker_, DECLARATION_TEMPLATE_PARAMS>
-constexpr Fractional<_NType, _Checker, _Checker_, TEMPLATE_PARAMS>
-Plus(const Fractional<_NType, _Checker, _Checker_, TEMPLATE_PARAMS> &lhs,
-     const Fractional<_NType, _Checker, _Checker_, TEMPLATE_PARAMS> &rhs) {
-    using Fract = Fractional<_NType, _Checker, _Checker_, TEMPLATE_PARAMS>;
-    using NaturalType = _NType;
-    using Divide = typename Fract::DivideOperator;
-    using Multiply = typename Fract::MultiplyOperator;
-    using Plus = typename Fract::PlusOperator;
-    using Equals = typename Fract::EqualOperator;
-
-    if (Equals{}(lhs.denominator(), rhs.denominator())) {
-        return Fract{Plus{}(lhs.nominator(), rhs.nominator()), lhs.denominator()};
-    }
-/*
- * Result's denominator is least common multiple of b, d or less
- */
-    auto lcm = utility::lcm<NaturalType, typename Fract::Checker>(
-            lhs.denominator(),
-            rhs.denominator());
-
-/*
- * Calculate b / lcm
- */
-    auto lhs_d_lcm = Divide{}(lhs.denominator(), lcm);
-
-/*
- * Calculate a * b/lcm
- */
-    auto lhs_ad_lcm = Multiply{}(lhs.nominator(), lhs_d_lcm);
-
-/*
- * Calculate d / lcm
- */
-    auto rhs_d_lcm = Divide{}(rhs.denominator(), lcm);
-
-/*
- * Calculate c * d/lcm
- */
-    auto rhs_cd_lcm = Multiply{}(rhs.nominator(), rhs_d_lcm);
-
-/*
- * Calculate a * b/lcm + c * d/lcm
- */
-    auto lhs_ad_lcm0rhs_cd_lcm = Plus{}(lhs_ad_lcm, rhs_cd_lcm);
-
-/*
- * Result (a * b/lcm + c * d/lcm)/lcm
- */
-    return Fract{
-            lhs_ad_lcm0rhs_cd_lcm, lcm};
-}
+NAMESPACE_FRACTIONAL_BEGIN
+    namespace {
+        /**
+         * @return -1, 0 or 1 for negative, zero or positive value
+         */
+        template<class _Fract>
+        constexpr int Sign(const typename _Fract::NaturalType &value) {
+            using NaturalType = typename _Fract::NaturalType;
+            using Less = typename _Fract::LessOperator;
+            using Greater = typename _Fract::GreaterOperator;
+
+            if (Greater{}(value, NaturalType{}))
+                return 1;
+            if (Less{}(value, NaturalType{}))
+                return -1;
+            return 0;
+        }
+
+        template<class _NaturalType>
+        constexpr bool IsNegative(const _NaturalType &value) noexcept {
+            if constexpr (std::is_signed_v<_NaturalType>) {
+                return value < 0;
+            } else {
+                return false;
+            }
+        }
+
+        /**
+         * |value| of built-in _NaturalType as the unsigned type of the same width
+         */
+        template<class _NaturalType>
+        constexpr std::make_unsigned_t<_NaturalType> Magnitude(const _NaturalType &value) noexcept {
+            using UType = std::make_unsigned_t<_NaturalType>;
+            return IsNegative(value) ? UType(UType{} - UType(value)) : UType(value);
+        }
+
+        using WideUnsigned = unsigned __int128;
+
+        /**
+         * a / b, 64-bit division when both fit: the 128-bit one is several times slower
+         */
+        inline WideUnsigned Quotient(WideUnsigned a, WideUnsigned b) noexcept {
+            if (((a | b) >> 64) == 0)
+                return std::uint64_t(a) / std::uint64_t(b);
+            return a / b;
+        }
+
+        /**
+         * Sign of a/b - c/d for b, d > 0, compares continued fraction expansions so nothing overflows
+         */
+        constexpr int CompareRatios(WideUnsigned a, WideUnsigned b,
+                                    WideUnsigned c, WideUnsigned d) noexcept {
+            while (true) {
+                auto lhs = a / b;
+                auto rhs = c / d;
+                if (lhs != rhs)
+                    return lhs < rhs ? -1 : 1;
+
+                auto lhs_remainder = a % b;
+                auto rhs_remainder = c % d;
+                if (lhs_remainder == 0)
+                    return rhs_remainder == 0 ? 0 : -1;
+                if (rhs_remainder == 0)
+                    return 1;
+    /*
+     * lhs_remainder/b - rhs_remainder/d has the sign of d/rhs_remainder - b/lhs_remainder
+     */
+                a = d;
+                d = lhs_remainder;
+                c = b;
+                b = rhs_remainder;
+            }
+        }
+
+        /**
+         * Sign of a/b - c/d for proper fractions of built-in _NaturalType, a and c zero or of the sign
+         * of b and d: compares products of magnitudes in the wider type, continued fractions without one
+         */
+        template<class _NaturalType>
+        constexpr int CompareProper(const _NaturalType &a, const _NaturalType &b,
+                                    const _NaturalType &c, const _NaturalType &d) noexcept {
+            if constexpr (utility::HasWider<_NaturalType>::value) {
+                using WideType = std::make_unsigned_t<utility::WiderType<_NaturalType>>;
+                auto lhs = WideType(Magnitude(a)) * Magnitude(d);
+                auto rhs = WideType(Magnitude(c)) * Magnitude(b);
+                return lhs == rhs ? 0 : lhs < rhs ? -1 : 1;
+            } else {
+                return CompareRatios(Magnitude(a), Magnitude(b), Magnitude(c), Magnitude(d));
+            }
+        }
 
-/**
- * @param lhs = a/b
- * @param rhs = c/d
- * @return Simplified a/b + c/d -> (a * b/lcm - c * d/lcm)/lcm
- */
-template<class _NType, template<class, template<class...> class, class...> class _Checker,
-        template<class...> class _Checker_, DECLARATION_TEMPLATE_PARAMS>
-constexpr Fractional<_NType, _Checker, _Checker_, TEMPLATE_PARAMS>
-Minus(const Fractional<_NType, _Checker, _Checker_, TEMPLATE_PARAMS> &lhs,
-      const Fractional<_NType, _Checker, _Checker_, TEMPLATE_PARAMS> &rhs) {
-    using Fract = Fractional<_NType, _Checker, _Checker_, TEMPLATE_PARAMS>;
-    using NaturalType = _NType;
-    using Divide = typename Fract::DivideOperator;
-    using Multiply = typename Fract::MultiplyOperator;
-    using Minus = typename Fract::MinusOperator;
-    using Equals = typename Fract::EqualOperator;
-
-    if (Equals{}(lhs.denominator(), rhs.denominator())) {
-        return Fract{Minus{}(lhs.nominator(), rhs.nominator()), lhs.denominator()};
+        /**
+         * Finalizer of splitmix64, every input bit affects every output bit
+         */
+        constexpr std::uint64_t MixHash(std::uint64_t value) noexcept {
+            value = (value ^ (value >> 30u)) * 0xBF58476D1CE4E5B9ull;
+            value = (value ^ (value >> 27u)) * 0x94D049BB133111EBull;
+            return value ^ (value >> 31u);
+        }
+
+        template<class _NaturalType>
+        std::size_t HashValue(const _NaturalType &value) {
+            if constexpr (std::is_integral_v<_NaturalType> && sizeof(_NaturalType) > 8) {
+                return std::size_t(MixHash(std::uint64_t(value) ^ MixHash(std::uint64_t(value >> 64u))));
+            } else if constexpr (std::is_integral_v<_NaturalType>) {
+                return std::size_t(MixHash(std::uint64_t(value)));
+            } else {
+                return std::hash<_NaturalType>{}(value);
+            }
+        }
+
+        /**
+         * Runs operation(result, rhs) on _Flagged copies with a clean OverflowStatus, then restores the status
+         */
+        template<class _Flagged, class _Fract, class _Operation>
+        Expected<_Fract> TryArithmetic(const _Fract &lhs, const _Fract &rhs, _Operation operation) noexcept {
+            static_assert(std::is_integral_v<typename _Fract::NaturalType>,
+                          "try_* arithmetic requires built-in NaturalType");
+            static_assert(_Flagged::IsNothrow, "FlagOnCheck arithmetic must not throw");
+            using overflow::OverflowStatus;
+
+            auto convert = [](const auto &value) {
+                using From = std::decay_t<decltype(value)>;
+                using To = std::conditional_t<std::is_same_v<From, _Fract>, _Flagged, _Fract>;
+                if constexpr (std::is_same_v<_Fract, _Flagged>) {
+                    return value;
+                } else {
+                    return To{value.nominator(), value.denominator()};
+                }
+            };
+
+            auto saved = OverflowStatus::Test();
+            OverflowStatus::Clear();
+            auto result = convert(lhs);
+            operation(result, convert(rhs));
+            auto raised = OverflowStatus::Test();
+            OverflowStatus::Set(saved);
+            if (raised != overflow::OverflowFlags::None)
+                return Expected<_Fract>{raised};
+            return Expected<_Fract>{convert(result)};
+        }
     }
 
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    template<class _Operator>
+    constexpr void Fractional<FRACTIONAL_TEMPLATE_PARAMS>::Accumulate(const Fractional &rhs) noexcept(IsNothrow) {
+        using Divide = DivideOperator;
+        using Multiply = MultiplyOperator;
+        using Equals = EqualOperator;
+
+        if constexpr (utility::IsWidening<Checker>::value) {
+            using Wide = typename Checker::WideType;
+            constexpr bool is_plus = std::is_same_v<_Operator, PlusOperator>;
+            auto combine = [](const Wide &lhs, const Wide &rhs) {
+                return is_plus ? Checker::WidePlus(lhs, rhs) : Checker::WideMinus(lhs, rhs);
+            };
+
+            if (Equals{}(denominator_, rhs.denominator_)) {
+                if constexpr (utility::IsInstrumented<Checker>::value) {
+                    Checker::OnSameDenominator();
+                }
+                AssignWide(combine(Wide(nominator_), Wide(rhs.nominator_)), Wide(denominator_));
+                return;
+            }
+    /*
+     * (a * d +- c * b)/(b * d), products of NaturalType always fit in WideType
+     */
+            AssignWide(combine(Wide(nominator_) * Wide(rhs.denominator_), Wide(rhs.nominator_) * Wide(denominator_)),
+                       Wide(denominator_) * Wide(rhs.denominator_));
+            return;
+        }
+
+        if (Equals{}(denominator_, rhs.denominator_)) {
+            if constexpr (utility::IsInstrumented<Checker>::value) {
+                Checker::OnSameDenominator();
+            }
+            nominator_ = _Operator{}(nominator_, rhs.nominator_);
+            Normalization::template OnResult<Fractional>(nominator_, denominator_);
+            return;
+        }
     /*
      * Result's denominator is least common multiple of b, d or less
      */
-    auto lcm = utility::lcm<NaturalType, typename Fract::Checker>(
-            lhs.denominator(),
-            rhs.denominator());
+        auto lcm = utility::lcm<NaturalType, Checker>(
+                denominator_,
+                rhs.denominator_);
 
     /*
-     * Calculate b / lcm
+     * Calculate a * lcm/b
      */
-    auto lhs_d_lcm = Divide{}(lhs.denominator(), lcm);
+        auto lhs_ad_lcm = Multiply{}(nominator_, Divide{}(lcm, denominator_));
 
     /*
-     * Calculate a * b/lcm
+     * Calculate c * lcm/d
      */
-    auto lhs_ad_lcm = Multiply{}(lhs.nominator(), lhs_d_lcm);
+        auto rhs_cd_lcm = Multiply{}(rhs.nominator_, Divide{}(lcm, rhs.denominator_));
 
     /*
-     * Calculate d / lcm
+     * Result (a * lcm/b +- c * lcm/d)/lcm
      */
-    auto rhs_d_lcm = Divide{}(rhs.denominator(), lcm);
+        nominator_ = _Operator{}(lhs_ad_lcm, rhs_cd_lcm);
+        denominator_ = std::move(lcm);
+        Normalization::template OnResult<Fractional>(nominator_, denominator_);
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr void Fractional<FRACTIONAL_TEMPLATE_PARAMS>::CrossMultiply(
+            const NaturalType &lhs_n, const NaturalType &lhs_d,
+            const NaturalType &rhs_n, const NaturalType &rhs_d) noexcept(IsNothrow) {
+        using Divide = DivideOperator;
+        using Multiply = MultiplyOperator;
+
+        if constexpr (utility::IsWidening<Checker>::value) {
+            using Wide = typename Checker::WideType;
+            AssignWide(Wide(lhs_n) * Wide(rhs_n), Wide(lhs_d) * Wide(rhs_d));
+            return;
+        }
 
     /*
-     * Calculate c * d/lcm
+     * Cancel common factors first so intermediates stay small
      */
-    auto rhs_cd_lcm = Multiply{}(rhs.nominator(), rhs_d_lcm);
+        auto lhs_gcd = utility::gcd<NaturalType, Checker>(lhs_n, rhs_d);
+        auto rhs_gcd = utility::gcd<NaturalType, Checker>(rhs_n, lhs_d);
+
+        auto nominator = Multiply{}(Divide{}(lhs_n, lhs_gcd), Divide{}(rhs_n, rhs_gcd));
+        auto denominator = Multiply{}(Divide{}(lhs_d, rhs_gcd), Divide{}(rhs_d, lhs_gcd));
+        Checker::CheckDivide(nominator, denominator);
+
+        nominator_ = std::move(nominator);
+        denominator_ = std::move(denominator);
+        Normalization::template OnResult<Fractional>(nominator_, denominator_);
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    template<class _WideType>
+    constexpr void Fractional<FRACTIONAL_TEMPLATE_PARAMS>::AssignWide(_WideType nominator, _WideType denominator) {
+        if constexpr (std::is_signed_v<_WideType>) {
+            if (denominator < 0) {
+                nominator = -nominator;
+                denominator = -denominator;
+            }
+        }
+
+        _WideType gcd{};
+        if constexpr (utility::IsInstrumented<Checker>::value) {
+            std::size_t iterations = 0;
+            gcd = utility::CountingGcd<_WideType, overflow::NoCheck<_WideType>>(nominator, denominator, &iterations);
+            Checker::OnGcd(iterations);
+        } else {
+            gcd = utility::gcd<_WideType, overflow::NoCheck<_WideType>>(nominator, denominator);
+        }
+        if (gcd > 1) {
+            nominator /= gcd;
+            denominator /= gcd;
+        }
 
     /*
-     * Calculate a * b/lcm - c * d/lcm
+     * The only range check of the whole operation, the result is already canonical
      */
-    auto lhs_ad_lcm0rhs_cd_lcm = Minus{}(lhs_ad_lcm, rhs_cd_lcm);
+        nominator_ = Checker::Narrow(nominator);
+        denominator_ = Checker::Narrow(denominator);
+        Checker::CheckDivide(nominator_, denominator_);
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS> &
+    Fractional<FRACTIONAL_TEMPLATE_PARAMS>::operator+=(const Fractional &rhs) noexcept(IsNothrow) {
+        Accumulate<PlusOperator>(rhs);
+        return *this;
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS> &
+    Fractional<FRACTIONAL_TEMPLATE_PARAMS>::operator-=(const Fractional &rhs) noexcept(IsNothrow) {
+        Accumulate<MinusOperator>(rhs);
+        return *this;
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS> &
+    Fractional<FRACTIONAL_TEMPLATE_PARAMS>::operator*=(const Fractional &rhs) noexcept(IsNothrow) {
+        CrossMultiply(nominator_, denominator_, rhs.nominator_, rhs.denominator_);
+        return *this;
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS> &
+    Fractional<FRACTIONAL_TEMPLATE_PARAMS>::operator/=(const Fractional &rhs) noexcept(IsNothrow) {
+        CrossMultiply(nominator_, denominator_, rhs.denominator_, rhs.nominator_);
+        return *this;
+    }
+
+    /**
+     * @param lhs = a/b
+     * @param rhs = c/d
+     * @return Simplified a/b + c/d -> (a * lcm/b + c * lcm/d)/lcm
+     */
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    Plus(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+         const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        auto result = lhs;
+        result += rhs;
+        return result;
+    }
+
+    /**
+     * @param lhs = a/b
+     * @param rhs = c/d
+     * @return Simplified a/b - c/d -> (a * lcm/b - c * lcm/d)/lcm
+     */
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    Minus(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+          const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        auto result = lhs;
+        result -= rhs;
+        return result;
+    }
+
+    /**
+     * @param lhs = a/b
+     * @param rhs = c/d
+     * @return a/b * c/d -> (a/gcd(a, d) * c/gcd(c, b))/(b/gcd(c, b) * d/gcd(a, d))
+     */
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    Multiply(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+             const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        auto result = lhs;
+        result *= rhs;
+        return result;
+    }
+
+    /**
+     * @param lhs = a/b
+     * @param rhs = c/d
+     * @return a/b / c/d -> (a/gcd(a, c) * d/gcd(d, b))/(b/gcd(d, b) * c/gcd(a, c))
+     */
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    Divide(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+           const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        auto result = lhs;
+        result /= rhs;
+        return result;
+    }
+
+    /**
+     * Rvalue lhs: the result is computed in place of lhs and moved out, heap-backed NaturalType
+     * reuses the storage of the operand instead of copying it
+     */
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    Plus(Fractional<FRACTIONAL_TEMPLATE_PARAMS> &&lhs,
+         const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        lhs += rhs;
+        return std::move(lhs);
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    Minus(Fractional<FRACTIONAL_TEMPLATE_PARAMS> &&lhs,
+          const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        lhs -= rhs;
+        return std::move(lhs);
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    Multiply(Fractional<FRACTIONAL_TEMPLATE_PARAMS> &&lhs,
+             const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        lhs *= rhs;
+        return std::move(lhs);
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    Divide(Fractional<FRACTIONAL_TEMPLATE_PARAMS> &&lhs,
+           const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        lhs /= rhs;
+        return std::move(lhs);
+    }
+
+    /**
+     * @param rhs = a/b
+     * @return -a/b
+     */
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    Negate(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        using Fract = Fractional<FRACTIONAL_TEMPLATE_PARAMS>;
+        using Negate = typename Fract::NegateOperator;
+
+        return Fract{Negate{}(rhs.nominator()), rhs.denominator()};
+    }
+
+    /**
+     * Three-way comparison of a/b and c/d.
+     * Values are brought to canonical form first if Normalization defers it.
+     * Signs are compared first, then integer parts floor(a/b) and floor(c/d),
+     * only equal integer parts fall back to cross-multiplication of the proper fractions.
+     * Built-in NaturalType multiplies in the wider type or compares continued fractions,
+     * so the comparison never overflows.
+     * @param lhs = a/b
+     * @param rhs = c/d
+     * @return negative if lhs < rhs, zero if lhs == rhs, positive if lhs > rhs
+     */
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr int Compare(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+                          const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        using Fract = Fractional<FRACTIONAL_TEMPLATE_PARAMS>;
+        using NaturalType = _NType;
+        using Divide = typename Fract::DivideOperator;
+        using Modulus = typename Fract::ModulusOperator;
+        using Multiply = typename Fract::MultiplyOperator;
+        using Plus = typename Fract::PlusOperator;
+        using Minus = typename Fract::MinusOperator;
+        using Equals = typename Fract::EqualOperator;
+        using Less = typename Fract::LessOperator;
+        using Normalization = typename Fract::Normalization;
+
+        auto lhs_n = lhs.nominator();
+        auto lhs_d = lhs.denominator();
+        Normalization::template OnRead<Fract>(lhs_n, lhs_d);
+        auto rhs_n = rhs.nominator();
+        auto rhs_d = rhs.denominator();
+        Normalization::template OnRead<Fract>(rhs_n, rhs_d);
+
+        auto lhs_d_sign = Sign<Fract>(lhs_d);
+        auto rhs_d_sign = Sign<Fract>(rhs_d);
+        auto lhs_sign = Sign<Fract>(lhs_n) * lhs_d_sign;
+        auto rhs_sign = Sign<Fract>(rhs_n) * rhs_d_sign;
+
+        if (lhs_sign != rhs_sign) {
+            return lhs_sign < rhs_sign ? -1 : 1;
+        }
+        if (lhs_sign == 0) {
+            return 0;
+        }
 
     /*
-     * Result (a * b/lcm - c * d/lcm)/lcm
+     * Integer parts: floor(a/b) with remainder r, 0 <= r/b < 1
      */
-    return Fract{lhs_ad_lcm0rhs_cd_lcm, lcm};
-}
+        auto lhs_int = Divide{}(lhs_n, lhs_d);
+        auto lhs_rem = Modulus{}(lhs_n, lhs_d);
+        if (Sign<Fract>(lhs_rem) * lhs_d_sign < 0) {
+            lhs_int = Minus{}(lhs_int, utility::One<NaturalType>());
+            lhs_rem = Plus{}(lhs_rem, lhs_d);
+        }
 
-template<class _NType, template<class, template<class...> class, class...> class _Checker,
-        template<class...> class _Checker_, DECLARATION_TEMPLATE_PARAMS>
-constexpr decltype(auto)
-operator-(const Fractional<_NType, _Checker, _Checker_, TEMPLATE_PARAMS> &lhs,
-      const Fractional<_NType, _Checker, _Checker_, TEMPLATE_PARAMS> &rhs) {
-    return Minus(lhs, rhs);
-}
+        auto rhs_int = Divide{}(rhs_n, rhs_d);
+        auto rhs_rem = Modulus{}(rhs_n, rhs_d);
+        if (Sign<Fract>(rhs_rem) * rhs_d_sign < 0) {
+            rhs_int = Minus{}(rhs_int, utility::One<NaturalType>());
+            rhs_rem = Plus{}(rhs_rem, rhs_d);
+        }
 
-template<class _NType, template<class, template<class...> class, class...> class _Checker,
-        template<class...> class _Checker_, DECLARATION_TEMPLATE_PARAMS>
-constexpr decltype(auto)
-operator+(const Fractional<_NType, _Checker, _Checker_, TEMPLATE_PARAMS> &lhs,
-          const Fractional<_NType, _Checker, _Checker_, TEMPLATE_PARAMS> &rhs) {
-    return Plus(lhs, rhs);
-}
+        if (!Equals{}(lhs_int, rhs_int)) {
+            return Less{}(lhs_int, rhs_int) ? -1 : 1;
+        }
 
+    /*
+     * Proper fractions r1/b and r2/d, both in [0, 1)
+     */
+        auto lhs_rem_zero = Equals{}(lhs_rem, NaturalType{});
+        auto rhs_rem_zero = Equals{}(rhs_rem, NaturalType{});
+        if (lhs_rem_zero || rhs_rem_zero) {
+            return int(rhs_rem_zero) - int(lhs_rem_zero);
+        }
 
-template<class _NType, template<class, template<class...> class, class...> class _Checker,
-        template<class...> class _Checker_, DECLARATION_TEMPLATE_PARAMS>
-std::ostream &operator<<(std::ostream &os, const Fractional<_NType, _Checker, _Checker_, TEMPLATE_PARAMS> &rhs) {
-    os << rhs.nominator() << '/' << rhs.denominator();
-    return os;
-}
+        if constexpr (std::is_integral_v<NaturalType>) {
+            return CompareProper(lhs_rem, lhs_d, rhs_rem, rhs_d);
+        }
 
-template<class _NType, template<class, template<class...> class, class...> class _Checker,
-        template<class...> class _Checker_, DECLARATION_TEMPLATE_PARAMS>
-std::wostream &operator<<(std::wostream &os, const Fractional<_NType, _Checker, _Checker_, TEMPLATE_PARAMS> &rhs) {
-    os << rhs.nominator() << '/' << rhs.denominator();
-    return os;
-}
+    /*
+     * r1/b < r2/d <=> (r1 * d - r2 * b) * sign(b * d) < 0
+     */
+        auto lhs_cross = Multiply{}(lhs_rem, rhs_d);
+        auto rhs_cross = Multiply{}(rhs_rem, lhs_d);
+        if (Equals{}(lhs_cross, rhs_cross)) {
+            return 0;
+        }
+        auto cross_sign = Less{}(lhs_cross, rhs_cross) ? -1 : 1;
+        return cross_sign * lhs_d_sign * rhs_d_sign;
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr decltype(auto)
+    operator-(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+              const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        return Minus(lhs, rhs);
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr decltype(auto)
+    operator+(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+              const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        return Plus(lhs, rhs);
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr decltype(auto)
+    operator*(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+              const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        return Multiply(lhs, rhs);
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr decltype(auto)
+    operator/(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+              const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        return Divide(lhs, rhs);
+    }
 
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    operator+(Fractional<FRACTIONAL_TEMPLATE_PARAMS> &&lhs,
+              const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        return Plus(std::move(lhs), rhs);
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    operator+(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+              Fractional<FRACTIONAL_TEMPLATE_PARAMS> &&rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        return Plus(std::move(rhs), lhs);
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    operator+(Fractional<FRACTIONAL_TEMPLATE_PARAMS> &&lhs,
+              Fractional<FRACTIONAL_TEMPLATE_PARAMS> &&rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        return Plus(std::move(lhs), rhs);
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    operator-(Fractional<FRACTIONAL_TEMPLATE_PARAMS> &&lhs,
+              const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        return Minus(std::move(lhs), rhs);
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    operator*(Fractional<FRACTIONAL_TEMPLATE_PARAMS> &&lhs,
+              const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        return Multiply(std::move(lhs), rhs);
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    operator*(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+              Fractional<FRACTIONAL_TEMPLATE_PARAMS> &&rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        return Multiply(std::move(rhs), lhs);
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    operator*(Fractional<FRACTIONAL_TEMPLATE_PARAMS> &&lhs,
+              Fractional<FRACTIONAL_TEMPLATE_PARAMS> &&rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        return Multiply(std::move(lhs), rhs);
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    operator/(Fractional<FRACTIONAL_TEMPLATE_PARAMS> &&lhs,
+              const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        return Divide(std::move(lhs), rhs);
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr decltype(auto)
+    operator-(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        return Negate(rhs);
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr bool operator==(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+                              const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        using Fract = Fractional<FRACTIONAL_TEMPLATE_PARAMS>;
+        using Equals = typename Fract::EqualOperator;
+
+        if constexpr (Fract::Normalization::IsCanonical) {
+            return Equals{}(lhs.nominator(), rhs.nominator()) && Equals{}(lhs.denominator(), rhs.denominator());
+        }
+        return Compare(lhs, rhs) == 0;
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr bool operator!=(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+                              const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        return !(lhs == rhs);
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr bool operator<(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+                             const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        return Compare(lhs, rhs) < 0;
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr bool operator<=(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+                              const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        return Compare(lhs, rhs) <= 0;
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr bool operator>(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+                             const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        return Compare(lhs, rhs) > 0;
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr bool operator>=(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+                              const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs)
+    noexcept(Fractional<FRACTIONAL_TEMPLATE_PARAMS>::IsNothrow) {
+        return Compare(lhs, rhs) >= 0;
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    Expected<Fractional<FRACTIONAL_TEMPLATE_PARAMS>>
+    try_add(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+            const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs) noexcept {
+        using Flagged = Fractional<_NType, overflow::FlagOnCheck, overflow::IntegralCheckOverflow, _Normalization,
+                TEMPLATE_PARAMS>;
+        return TryArithmetic<Flagged>(lhs, rhs, [](Flagged &result, const Flagged &value) {
+            result += value;
+        });
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    Expected<Fractional<FRACTIONAL_TEMPLATE_PARAMS>>
+    try_sub(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+            const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs) noexcept {
+        using Flagged = Fractional<_NType, overflow::FlagOnCheck, overflow::IntegralCheckOverflow, _Normalization,
+                TEMPLATE_PARAMS>;
+        return TryArithmetic<Flagged>(lhs, rhs, [](Flagged &result, const Flagged &value) {
+            result -= value;
+        });
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    Expected<Fractional<FRACTIONAL_TEMPLATE_PARAMS>>
+    try_mul(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs,
+            const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs) noexcept {
+        using Flagged = Fractional<_NType, overflow::FlagOnCheck, overflow::IntegralCheckOverflow, _Normalization,
+                TEMPLATE_PARAMS>;
+        return TryArithmetic<Flagged>(lhs, rhs, [](Flagged &result, const Flagged &value) {
+            result *= value;
+        });
+    }
+
+    namespace {
+        /**
+         * (negative ? -1 : 1) * magnitude/divisor correctly rounded to T in the current rounding mode.
+         * The quotient is cut to two bits more than T can hold at its exponent, with a nonzero
+         * remainder folded into the lowest bit, so the one rounding of the final conversion is exact.
+         */
+        template<class T>
+        T RoundQuotient(WideUnsigned magnitude, WideUnsigned divisor, bool negative) noexcept {
+            constexpr int digits = std::numeric_limits<T>::digits;
+            constexpr int min_exponent = std::numeric_limits<T>::min_exponent - 1;
+            auto width = [](WideUnsigned value) {
+                return int(utility::BitWidth(value));
+            };
+
+            auto quotient = Quotient(magnitude, divisor);
+            auto remainder = magnitude - quotient * divisor;
+            int shift = 0;
+    /*
+     * Long division by chunks as wide as the shifted remainder allows, bit by bit for 128-bit divisors
+     */
+            auto chunk_limit = 128 - width(divisor);
+            while (width(quotient) < digits + 2 && remainder != 0) {
+                if (chunk_limit == 0) {
+                    bool carry = (remainder >> 127) != 0;
+                    remainder <<= 1;
+                    bool bit = carry || remainder >= divisor;
+                    if (bit)
+                        remainder -= divisor;
+                    quotient = (quotient << 1) | WideUnsigned(bit);
+                    ++shift;
+                    continue;
+                }
+                auto chunk = std::min(digits + 2 - width(quotient), chunk_limit);
+                remainder <<= chunk;
+                auto digit = Quotient(remainder, divisor);
+                remainder -= digit * divisor;
+                quotient = (quotient << chunk) | digit;
+                shift += chunk;
+            }
+
+            auto exponent = width(quotient) - 1 - shift;
+            auto precision = digits + 2;
+            if (exponent < min_exponent)
+                precision = std::max(digits - (min_exponent - exponent), 0) + 2;
+
+            bool sticky = remainder != 0;
+            if (width(quotient) > precision) {
+                auto extra = width(quotient) - precision;
+                sticky |= (quotient & ((WideUnsigned(1) << extra) - 1)) != 0;
+                quotient >>= extra;
+                shift -= extra;
+            }
+            quotient |= WideUnsigned(sticky);
+
+            auto value = T(negative ? -__int128(quotient) : __int128(quotient));
+            return std::ldexp(value, -shift);
+        }
+
+        /**
+         * nominator/denominator correctly rounded to T, operands exact in T are divided directly
+         */
+        template<class T, class _NaturalType>
+        constexpr T ToFloating(const _NaturalType &nominator, const _NaturalType &denominator) noexcept {
+            constexpr int digits = std::numeric_limits<T>::digits;
+            if constexpr (std::numeric_limits<_NaturalType>::digits <= digits) {
+                return T(nominator) / T(denominator);
+            } else {
+                using UType = std::make_unsigned_t<_NaturalType>;
+                constexpr auto exact = UType(UType(1) << digits);
+                auto magnitude = [](const _NaturalType &value) {
+                    if constexpr (std::is_signed_v<_NaturalType>) {
+                        if (value < 0)
+                            return UType(UType{} - UType(value));
+                    }
+                    return UType(value);
+                };
+
+                auto nominator_magnitude = magnitude(nominator);
+                auto denominator_magnitude = magnitude(denominator);
+                if (nominator_magnitude <= exact && denominator_magnitude <= exact)
+                    return T(nominator) / T(denominator);
+                return RoundQuotient<T>(nominator_magnitude, denominator_magnitude,
+                                        (nominator < _NaturalType{}) != (denominator < _NaturalType{}));
+            }
+        }
+
+        /**
+         * |x| = nominator/denominator exactly for |x| < 2^127, bits below 2^-127 are dropped
+         */
+        inline std::pair<WideUnsigned, WideUnsigned> ExactMagnitude(double x) noexcept {
+            int exponent = 0;
+            auto mantissa = WideUnsigned(std::ldexp(std::frexp(std::fabs(x), &exponent), 53));
+            exponent -= 53;
+            if (mantissa == 0)
+                return {0, 1};
+
+            for (; exponent < 0 && (mantissa & 1) == 0; ++exponent) {
+                mantissa >>= 1;
+            }
+            for (; exponent < -127; ++exponent) {
+                mantissa >>= 1;
+            }
+            if (exponent >= 0)
+                return {mantissa << exponent, 1};
+            return {mantissa, WideUnsigned(1) << -exponent};
+        }
+
+        /**
+         * Walks the convergents p/q of n/d keeping p <= max_nominator and q <= max_denominator.
+         * With negative tolerance returns the closer of the last convergent and the last semiconvergent
+         * within bounds, otherwise the first convergent or semiconvergent within tolerance.
+         */
+        inline std::pair<WideUnsigned, WideUnsigned>
+        BestApproximation(WideUnsigned n, WideUnsigned d, WideUnsigned max_nominator,
+                          WideUnsigned max_denominator, long double tolerance) noexcept {
+            constexpr auto unbounded = ~WideUnsigned{};
+            if (tolerance >= 0 && (long double) n / (long double) d <= tolerance)
+                return {0, 1};
+
+            WideUnsigned p0 = 0, q0 = 1, p1 = 1, q1 = 0;
+            while (true) {
+                auto quotient = Quotient(n, d);
+                auto steps = [&] {
+                    return std::min(q1 != 0 ? Quotient(max_denominator - q0, q1) : unbounded,
+                                    p1 != 0 ? Quotient(max_nominator - p0, p1) : unbounded);
+                };
+                WideUnsigned p2, q2;
+                bool fits = !__builtin_mul_overflow(quotient, p1, &p2) && !__builtin_add_overflow(p2, p0, &p2) &&
+                            !__builtin_mul_overflow(quotient, q1, &q2) && !__builtin_add_overflow(q2, q0, &q2) &&
+                            p2 <= max_nominator && q2 <= max_denominator;
+                if (tolerance >= 0) {
+    /*
+     * (p0 + m * p1)/(q0 + m * q1) is off by (r - m)/((q0 + m * q1) * (q1 * r + q0)) for the complete
+     * quotient r = n/d, decreasing in m. The smallest m within tolerance is solved in long double
+     * and then fixed up by checking the error directly.
+     */
+                    auto r = (long double) n / (long double) d;
+                    auto weight = (long double) q1 * r + (long double) q0;
+                    auto error = [&](WideUnsigned m) {
+                        auto steps_taken = (long double) m;
+                        return (r - steps_taken) / (((long double) q0 + steps_taken * (long double) q1) * weight);
+                    };
+
+                    auto limit = fits ? quotient : steps();
+                    auto solved = std::ceil((r - tolerance * (long double) q0 * weight) /
+                                            (1 + tolerance * (long double) q1 * weight));
+                    if (solved <= (long double) limit) {
+                        auto m = WideUnsigned(std::max(solved, 1.0L));
+                        while (m < limit && error(m) > tolerance) {
+                            ++m;
+                        }
+                        while (m > 1 && error(m - 1) <= tolerance) {
+                            --m;
+                        }
+                        if (error(m) <= tolerance)
+                            return {p0 + m * p1, q0 + m * q1};
+                    }
+                }
+
+                if (!fits) {
+    /*
+     * The semiconvergent with the largest k within bounds is closer than p1/q1 iff r < 2k + q0/q1,
+     * ties go to the smaller denominator p1/q1
+     */
+                    auto k = steps();
+                    bool semiconvergent = k > quotient - k ||
+                                          (k == quotient - k && CompareRatios(n - quotient * d, d, q0, q1) < 0);
+                    if (semiconvergent)
+                        return {p0 + k * p1, q0 + k * q1};
+                    return {p1, q1};
+                }
+
+                p0 = p1;
+                q0 = q1;
+                p1 = p2;
+                q1 = q2;
+
+                auto remainder = n - quotient * d;
+                if (remainder == 0)
+                    return {p1, q1};
+                n = d;
+                d = remainder;
+            }
+        }
+
+        /**
+         * Shared body of approximate and approximate_within, negative tolerance for the closest fraction.
+         * @return canonical nominator and denominator
+         */
+        template<class _NaturalType>
+        std::pair<_NaturalType, _NaturalType> Approximate(double x, const _NaturalType &max_denominator,
+                                                          long double tolerance) noexcept {
+            static_assert(std::is_integral_v<_NaturalType>, "approximate requires built-in NaturalType");
+            assert(std::isfinite(x) && max_denominator > 0);
+
+            constexpr auto max = std::numeric_limits<_NaturalType>::max();
+            bool negative = x < 0;
+            if constexpr (std::is_unsigned_v<_NaturalType>) {
+                if (negative)
+                    return {0, 1};
+            }
+            if (!(std::fabs(x) < 0x1p127))
+                return {negative ? _NaturalType(-max) : max, 1};
+            auto [n, d] = ExactMagnitude(x);
+            if (Quotient(n, d) >= WideUnsigned(max))
+                return {negative ? _NaturalType(-max) : max, 1};
+
+            auto [p, q] = BestApproximation(n, d, WideUnsigned(max), WideUnsigned(max_denominator),
+                                            tolerance);
+            auto nominator = _NaturalType(p);
+            return {negative ? _NaturalType(-nominator) : nominator, _NaturalType(q)};
+        }
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    Fractional<FRACTIONAL_TEMPLATE_PARAMS>::approximate(double x,
+                                                        const NaturalType &max_denominator) noexcept {
+        auto [nominator, denominator] = Approximate(x, max_denominator, -1);
+        return Fractional{nominator, denominator, CanonicalTag{}};
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    Fractional<FRACTIONAL_TEMPLATE_PARAMS>::approximate_within(double x, double tolerance,
+                                                               const NaturalType &max_denominator) noexcept {
+        assert(tolerance >= 0);
+        auto [nominator, denominator] = Approximate(x, max_denominator, tolerance);
+        return Fractional{nominator, denominator, CanonicalTag{}};
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    template<class T, typename>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>::operator T() const noexcept(std::is_integral_v<NaturalType>) {
+        if constexpr (std::is_integral_v<NaturalType>) {
+            return ToFloating<T>(nominator_, denominator_);
+        } else {
+            return std::divides<T>{}(nominator_, denominator_);
+        }
+    }
+
+    template<class _Fract>
+    void to_double(const _Fract *first, const _Fract *last, double *out) noexcept {
+        using NaturalType = typename _Fract::NaturalType;
+        using UType = std::make_unsigned_t<NaturalType>;
+        static_assert(std::is_integral_v<NaturalType>, "to_double requires built-in NaturalType");
+        constexpr int digits = std::numeric_limits<double>::digits;
+
+        auto size = std::size_t(last - first);
+        if constexpr (std::numeric_limits<NaturalType>::digits <= digits) {
+            for (std::size_t i = 0; i < size; ++i) {
+                out[i] = double(first[i].nominator()) / double(first[i].denominator());
+            }
+        } else {
+    /*
+     * Branch-free pass over all values, the rare inexact operands are redone one by one
+     */
+            constexpr auto bound = UType(UType(1) << digits);
+            auto inexact = [](const NaturalType &value) {
+                if constexpr (std::is_signed_v<NaturalType>) {
+                    return UType(value) + bound > 2 * bound;
+                } else {
+                    return value > bound;
+                }
+            };
+
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < size; ++i) {
+                auto nominator = first[i].nominator();
+                auto denominator = first[i].denominator();
+                out[i] = double(nominator) / double(denominator);
+                count += inexact(nominator) | inexact(denominator);
+            }
+            for (std::size_t i = 0; count != 0 && i < size; ++i) {
+                if (inexact(first[i].nominator()) || inexact(first[i].denominator())) {
+                    out[i] = double(first[i]);
+                    --count;
+                }
+            }
+        }
+    }
+
+    template<class _Fract>
+    void approximate(const double *first, const double *last, _Fract *out,
+                     const typename _Fract::NaturalType &max_denominator) noexcept {
+        for (; first != last; ++first, ++out) {
+            *out = _Fract::approximate(*first, max_denominator);
+        }
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    std::ostream &operator<<(std::ostream &os, const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs) {
+        using Fract = Fractional<FRACTIONAL_TEMPLATE_PARAMS>;
+
+        auto nominator = rhs.nominator();
+        auto denominator = rhs.denominator();
+        Fract::Normalization::template OnRead<Fract>(nominator, denominator);
+        os << nominator << '/' << denominator;
+        return os;
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    std::wostream &operator<<(std::wostream &os, const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs) {
+        using Fract = Fractional<FRACTIONAL_TEMPLATE_PARAMS>;
+
+        auto nominator = rhs.nominator();
+        auto denominator = rhs.denominator();
+        Fract::Normalization::template OnRead<Fract>(nominator, denominator);
+        os << nominator << '/' << denominator;
+        return os;
+    }
+NAMESPACE_FRACTIONAL_END
+
+template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+std::size_t std::hash<fractional::Fractional<FRACTIONAL_TEMPLATE_PARAMS>>::operator()(
+        const fractional::Fractional<FRACTIONAL_TEMPLATE_PARAMS> &value) const {
+    using Fract = fractional::Fractional<FRACTIONAL_TEMPLATE_PARAMS>;
+
+    auto nominator = value.nominator();
+    auto denominator = value.denominator();
+    if constexpr (!Fract::Normalization::IsCanonical) {
+        fractional::normalization::Reduce<Fract>(nominator, denominator);
+    }
+    auto hash = fractional::HashValue(nominator);
+    return hash ^ (fractional::HashValue(denominator) + 0x9E3779B97F4A7C15ull + (hash << 6u) + (hash >> 2u));
+}
 
 #endif //FRACTIONNUMBER_FRACTIONAL_HXX
@@ -0,0 +1,213 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_FRACTIONVECTOR_HPP
+#define FRACTIONNUMBER_FRACTIONVECTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "fractional.hpp"
+#include "utility.hpp"
+
+/**
+ * Batched kernels over built-in integer lanes. Every lane is computed branch-free in the
+ * twice wider type and stored unreduced, lanes whose result does not fit are flagged in
+ * the overflow mask instead of throwing. 64-bit lanes have no wider type, they use overflow
+ * builtins and are also flagged when an intermediate product does not fit.
+ * The body is compiled once per instruction set, AVX-512 or AVX2 is picked at runtime
+ * when the processor supports it; it auto-vectorizes at -O3.
+ */
+namespace fractional::simd {
+    enum class Operation {
+        Add,
+        Subtract,
+        Multiply,
+        Divide
+    };
+
+    enum class Level {
+        Scalar,
+        AVX2,
+        AVX512
+    };
+
+    /**
+     * @return best instruction set supported by the running processor, detected once
+     */
+    inline Level DetectLevel() noexcept;
+
+    /**
+     * n[i]/den[i] = a[i]/b[i] _Op c[i]/d[i], with c and d read at index 0 when _Broadcast.
+     * _SameDenominator requires b[i] == d[i] and turns Add and Subtract into a plain
+     * nominator add, den[i] = b[i].
+     * @return number of lanes flagged in mask
+     */
+    template<Operation _Op, bool _Broadcast, bool _SameDenominator, class T>
+    std::size_t Kernel(const T *a, const T *b, const T *c, const T *d,
+                       T *n, T *den, std::uint8_t *mask, std::size_t size);
+
+    /**
+     * @return true if b[i] == d[i] for every lane, d is read at index 0 when _Broadcast
+     */
+    template<bool _Broadcast, class T>
+    bool SameDenominator(const T *b, const T *d, std::size_t size) noexcept;
+}
+
+NAMESPACE_FRACTIONAL_BEGIN
+    /**
+     * Lane i is 1 if the i-th result of a kernel overflowed, its nominator and denominator are unspecified
+     */
+    using OverflowMask = std::vector<std::uint8_t, utility::AlignedAllocator<std::uint8_t>>;
+
+    /**
+     * Structure-of-arrays column of fractions: nominators and denominators
+     * live in separate 64-byte aligned arrays so kernels can stream over them.
+     * Values are kept as stored, kernels do not reduce, call reduce() when needed.
+     */
+    template<class _NaturalType>
+    class FractionVector {
+        static_assert(std::is_integral_v<_NaturalType> && sizeof(_NaturalType) <= 8,
+                      "FractionVector lanes must be built-in integers up to 64 bits");
+
+    public:
+        using NaturalType = _NaturalType;
+        using Storage = std::vector<NaturalType, utility::AlignedAllocator<NaturalType>>;
+
+        FractionVector() = default;
+
+        /**
+         * size zeros, 0/1
+         */
+        explicit FractionVector(std::size_t size)
+                : nominators_(size), denominators_(size, utility::One<NaturalType>()) {}
+
+        /**
+         * Copies fractions from [first, last)
+         */
+        template<class _InputIt>
+        FractionVector(_InputIt first, _InputIt last) {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        }
+
+        std::size_t size() const noexcept {
+            return nominators_.size();
+        }
+
+        bool empty() const noexcept {
+            return nominators_.empty();
+        }
+
+        void reserve(std::size_t size) {
+            nominators_.reserve(size);
+            denominators_.reserve(size);
+        }
+
+        /**
+         * New lanes are 0/1
+         */
+        void resize(std::size_t size) {
+            nominators_.resize(size);
+            denominators_.resize(size, utility::One<NaturalType>());
+        }
+
+        void clear() noexcept {
+            nominators_.clear();
+            denominators_.clear();
+        }
+
+        void push_back(const NaturalType &nominator, const NaturalType &denominator) {
+            nominators_.push_back(nominator);
+            denominators_.push_back(denominator);
+        }
+
+        template<class _Fract>
+        void push_back(const _Fract &value) {
+            push_back(value.nominator(), value.denominator());
+        }
+
+        NaturalType *nominators() noexcept {
+            return nominators_.data();
+        }
+
+        const NaturalType *nominators() const noexcept {
+            return nominators_.data();
+        }
+
+        NaturalType *denominators() noexcept {
+            return denominators_.data();
+        }
+
+        const NaturalType *denominators() const noexcept {
+            return denominators_.data();
+        }
+
+        /**
+         * @return i-th lane as _Fract, normalized by its constructor
+         */
+        template<class _Fract = Fractional<NaturalType>>
+        _Fract at(std::size_t i) const {
+            return _Fract{nominators_.at(i), denominators_.at(i)};
+        }
+
+        template<class _Fract>
+        void set(std::size_t i, const _Fract &value) {
+            nominators_.at(i) = value.nominator();
+            denominators_.at(i) = value.denominator();
+        }
+
+        /**
+         * Brings every lane to canonical form through normalization::Reduce of _Fract
+         */
+        template<class _Fract = Fractional<NaturalType>>
+        void reduce();
+
+    private:
+        Storage nominators_;
+        Storage denominators_;
+    };
+
+    /**
+     * Element-wise out[i] = lhs[i] op rhs[i]. Sizes must match, out may alias an operand.
+     * Lanes whose result overflows NaturalType, or divide by zero, are set in mask.
+     * @return number of overflowed lanes
+     */
+    template<class T>
+    std::size_t add(const FractionVector<T> &lhs, const FractionVector<T> &rhs,
+                    FractionVector<T> &out, OverflowMask &mask);
+
+    template<class T>
+    std::size_t sub(const FractionVector<T> &lhs, const FractionVector<T> &rhs,
+                    FractionVector<T> &out, OverflowMask &mask);
+
+    template<class T>
+    std::size_t mul(const FractionVector<T> &lhs, const FractionVector<T> &rhs,
+                    FractionVector<T> &out, OverflowMask &mask);
+
+    template<class T>
+    std::size_t div(const FractionVector<T> &lhs, const FractionVector<T> &rhs,
+                    FractionVector<T> &out, OverflowMask &mask);
+
+    /**
+     * Broadcast out[i] = lhs[i] op rhs, rhs is any fraction with nominator() and denominator()
+     */
+    template<class T, class _Fract, typename = decltype(std::declval<const _Fract &>().denominator())>
+    std::size_t add(const FractionVector<T> &lhs, const _Fract &rhs, FractionVector<T> &out, OverflowMask &mask);
+
+    template<class T, class _Fract, typename = decltype(std::declval<const _Fract &>().denominator())>
+    std::size_t sub(const FractionVector<T> &lhs, const _Fract &rhs, FractionVector<T> &out, OverflowMask &mask);
+
+    template<class T, class _Fract, typename = decltype(std::declval<const _Fract &>().denominator())>
+    std::size_t mul(const FractionVector<T> &lhs, const _Fract &rhs, FractionVector<T> &out, OverflowMask &mask);
+
+    template<class T, class _Fract, typename = decltype(std::declval<const _Fract &>().denominator())>
+    std::size_t div(const FractionVector<T> &lhs, const _Fract &rhs, FractionVector<T> &out, OverflowMask &mask);
+NAMESPACE_FRACTIONAL_END
+
+#include "fractionvector.hxx"
+
+#endif //FRACTIONNUMBER_FRACTIONVECTOR_HPP
@@ -0,0 +1,347 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_FRACTIONVECTOR_HXX
+#define FRACTIONNUMBER_FRACTIONVECTOR_HXX
+
+#include <stdexcept>
+#include "fractionvector.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define FRACTIONAL_SIMD_DISPATCH 1
+#else
+#define FRACTIONAL_SIMD_DISPATCH 0
+#endif
+
+#define FRACTIONAL_ALWAYS_INLINE __attribute__((always_inline)) inline
+
+namespace fractional::simd {
+    inline Level DetectLevel() noexcept {
+#if FRACTIONAL_SIMD_DISPATCH
+        static const Level level = [] {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+                __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl"))
+                return Level::AVX512;
+            if (__builtin_cpu_supports("avx2"))
+                return Level::AVX2;
+            return Level::Scalar;
+        }();
+        return level;
+#else
+        return Level::Scalar;
+#endif
+    }
+
+    /**
+     * Lanes up to 32 bits are computed in a type at least twice as wide, where products cannot overflow.
+     * 16-bit and narrower lanes use 32 bits to stay away from integer promotion.
+     */
+    template<class T>
+    using LaneWide = std::conditional_t<sizeof(T) <= 2,
+            std::conditional_t<std::is_signed_v<T>, std::int32_t, std::uint32_t>,
+            std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+
+    template<class W>
+    FRACTIONAL_ALWAYS_INLINE bool AddOverflow(W lhs, W rhs, W &result) noexcept {
+        using UType = std::make_unsigned_t<W>;
+        result = W(UType(lhs) + UType(rhs));
+        if constexpr (std::is_signed_v<W>) {
+            return ((lhs ^ result) & (rhs ^ result)) < 0;
+        } else {
+            return result < lhs;
+        }
+    }
+
+    template<class W>
+    FRACTIONAL_ALWAYS_INLINE bool SubtractOverflow(W lhs, W rhs, W &result) noexcept {
+        using UType = std::make_unsigned_t<W>;
+        result = W(UType(lhs) - UType(rhs));
+        if constexpr (std::is_signed_v<W>) {
+            return ((lhs ^ rhs) & (lhs ^ result)) < 0;
+        } else {
+            return lhs < rhs;
+        }
+    }
+
+    template<class T, class W>
+    FRACTIONAL_ALWAYS_INLINE bool Fits(W value) noexcept {
+        return W(T(value)) == value;
+    }
+
+    /**
+     * One lane without branches
+     * @return true if the result does not fit T or the divisor is zero
+     */
+    template<Operation _Op, bool _SameDenominator, class T>
+    FRACTIONAL_ALWAYS_INLINE bool Lane(T a, T b, T c, T d, T &n, T &den) noexcept {
+        constexpr bool additive = _Op == Operation::Add || _Op == Operation::Subtract;
+
+        if constexpr (sizeof(T) <= 4) {
+            using W = LaneWide<T>;
+            W wa = a, wb = b, wc = c, wd = d;
+            W wn{}, wden{};
+            bool overflow = false;
+
+            if constexpr (additive && _SameDenominator) {
+    /*
+     * Same denominators: the sum of two lanes always fits the wide type
+     */
+                wn = _Op == Operation::Add ? W(wa + wc) : W(wa - wc);
+                wden = wb;
+            } else if constexpr (additive) {
+                if constexpr (_Op == Operation::Add) {
+                    overflow = AddOverflow(W(wa * wd), W(wc * wb), wn);
+                } else {
+                    overflow = SubtractOverflow(W(wa * wd), W(wc * wb), wn);
+                }
+                wden = W(wb * wd);
+            } else if constexpr (_Op == Operation::Multiply) {
+                wn = W(wa * wc);
+                wden = W(wb * wd);
+            } else {
+                wn = W(wa * wd);
+                wden = W(wb * wc);
+                if constexpr (std::is_signed_v<T>) {
+                    W sign = wden < 0 ? W(-1) : W(1);
+                    wn = W(wn * sign);
+                    wden = W(wden * sign);
+                }
+                overflow = wden == 0;
+            }
+
+            n = T(wn);
+            den = T(wden);
+            return overflow | !Fits<T>(wn) | !Fits<T>(wden);
+        } else {
+            bool overflow = false;
+
+            if constexpr (additive && _SameDenominator) {
+                overflow = _Op == Operation::Add ? __builtin_add_overflow(a, c, &n)
+                                                 : __builtin_sub_overflow(a, c, &n);
+                den = b;
+            } else if constexpr (additive) {
+                T lhs{}, rhs{};
+                overflow = __builtin_mul_overflow(a, d, &lhs);
+                overflow |= __builtin_mul_overflow(c, b, &rhs);
+                overflow |= _Op == Operation::Add ? __builtin_add_overflow(lhs, rhs, &n)
+                                                  : __builtin_sub_overflow(lhs, rhs, &n);
+                overflow |= __builtin_mul_overflow(b, d, &den);
+            } else if constexpr (_Op == Operation::Multiply) {
+                overflow = __builtin_mul_overflow(a, c, &n);
+                overflow |= __builtin_mul_overflow(b, d, &den);
+            } else {
+                overflow = __builtin_mul_overflow(a, d, &n);
+                overflow |= __builtin_mul_overflow(b, c, &den);
+                if constexpr (std::is_signed_v<T>) {
+                    bool negative = den < 0;
+                    overflow |= negative & ((n == std::numeric_limits<T>::lowest()) |
+                                            (den == std::numeric_limits<T>::lowest()));
+                    using UType = std::make_unsigned_t<T>;
+                    UType flip = UType{} - UType(negative);
+                    n = T((UType(n) ^ flip) + UType(negative));
+                    den = T((UType(den) ^ flip) + UType(negative));
+                }
+                overflow |= den == 0;
+            }
+            return overflow;
+        }
+    }
+
+    template<Operation _Op, bool _Broadcast, bool _SameDenominator, class T>
+    FRACTIONAL_ALWAYS_INLINE std::size_t KernelBody(const T *a, const T *b, const T *c, const T *d,
+                                                    T *n, T *den, std::uint8_t *mask, std::size_t size) noexcept {
+        const T c0 = _Broadcast ? c[0] : T{};
+        const T d0 = _Broadcast ? d[0] : T{};
+        for (std::size_t i = 0; i < size; ++i) {
+            T result_n{}, result_den{};
+            bool overflow = Lane<_Op, _SameDenominator>(a[i], b[i], _Broadcast ? c0 : c[i], _Broadcast ? d0 : d[i],
+                                                        result_n, result_den);
+            n[i] = result_n;
+            den[i] = result_den;
+            mask[i] = std::uint8_t(overflow);
+        }
+    /*
+     * Counted in a separate pass, a counter wider than the lanes would keep the loop above scalar
+     */
+        std::size_t overflows = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+            overflows += mask[i];
+        }
+        return overflows;
+    }
+
+    template<bool _Broadcast, class T>
+    FRACTIONAL_ALWAYS_INLINE bool SameDenominatorBody(const T *b, const T *d, std::size_t size) noexcept {
+        const T d0 = _Broadcast ? d[0] : T{};
+        T differ{};
+        for (std::size_t i = 0; i < size; ++i) {
+            differ |= T(b[i] ^ (_Broadcast ? d0 : d[i]));
+        }
+        return differ == T{};
+    }
+
+#if FRACTIONAL_SIMD_DISPATCH
+    template<Operation _Op, bool _Broadcast, bool _SameDenominator, class T>
+    __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl")))
+    std::size_t KernelAVX512(const T *a, const T *b, const T *c, const T *d,
+                             T *n, T *den, std::uint8_t *mask, std::size_t size) noexcept {
+        return KernelBody<_Op, _Broadcast, _SameDenominator>(a, b, c, d, n, den, mask, size);
+    }
+
+    template<Operation _Op, bool _Broadcast, bool _SameDenominator, class T>
+    __attribute__((target("avx2")))
+    std::size_t KernelAVX2(const T *a, const T *b, const T *c, const T *d,
+                           T *n, T *den, std::uint8_t *mask, std::size_t size) noexcept {
+        return KernelBody<_Op, _Broadcast, _SameDenominator>(a, b, c, d, n, den, mask, size);
+    }
+
+    template<bool _Broadcast, class T>
+    __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl")))
+    bool SameDenominatorAVX512(const T *b, const T *d, std::size_t size) noexcept {
+        return SameDenominatorBody<_Broadcast>(b, d, size);
+    }
+
+    template<bool _Broadcast, class T>
+    __attribute__((target("avx2")))
+    bool SameDenominatorAVX2(const T *b, const T *d, std::size_t size) noexcept {
+        return SameDenominatorBody<_Broadcast>(b, d, size);
+    }
+#endif
+
+    template<Operation _Op, bool _Broadcast, bool _SameDenominator, class T>
+    std::size_t KernelScalar(const T *a, const T *b, const T *c, const T *d,
+                             T *n, T *den, std::uint8_t *mask, std::size_t size) noexcept {
+        return KernelBody<_Op, _Broadcast, _SameDenominator>(a, b, c, d, n, den, mask, size);
+    }
+
+    template<Operation _Op, bool _Broadcast, bool _SameDenominator, class T>
+    std::size_t Kernel(const T *a, const T *b, const T *c, const T *d,
+                       T *n, T *den, std::uint8_t *mask, std::size_t size) {
+#if FRACTIONAL_SIMD_DISPATCH
+        switch (DetectLevel()) {
+            case Level::AVX512:
+                return KernelAVX512<_Op, _Broadcast, _SameDenominator>(a, b, c, d, n, den, mask, size);
+            case Level::AVX2:
+                return KernelAVX2<_Op, _Broadcast, _SameDenominator>(a, b, c, d, n, den, mask, size);
+            default:
+                break;
+        }
+#endif
+        return KernelScalar<_Op, _Broadcast, _SameDenominator>(a, b, c, d, n, den, mask, size);
+    }
+
+    template<bool _Broadcast, class T>
+    bool SameDenominator(const T *b, const T *d, std::size_t size) noexcept {
+#if FRACTIONAL_SIMD_DISPATCH
+        switch (DetectLevel()) {
+            case Level::AVX512:
+                return SameDenominatorAVX512<_Broadcast>(b, d, size);
+            case Level::AVX2:
+                return SameDenominatorAVX2<_Broadcast>(b, d, size);
+            default:
+                break;
+        }
+#endif
+        return SameDenominatorBody<_Broadcast>(b, d, size);
+    }
+
+    /**
+     * Sizes out and mask, takes the same-denominator kernel for Add and Subtract when every lane allows it
+     */
+    template<Operation _Op, bool _Broadcast, class T>
+    std::size_t Apply(const FractionVector<T> &lhs, const T *c, const T *d,
+                      FractionVector<T> &out, OverflowMask &mask) {
+        auto size = lhs.size();
+        out.resize(size);
+        mask.resize(size);
+        if (size == 0)
+            return 0;
+
+        if constexpr (_Op == Operation::Add || _Op == Operation::Subtract) {
+            if (SameDenominator<_Broadcast>(lhs.denominators(), d, size)) {
+                return Kernel<_Op, _Broadcast, true>(lhs.nominators(), lhs.denominators(), c, d,
+                                                     out.nominators(), out.denominators(), mask.data(), size);
+            }
+        }
+        return Kernel<_Op, _Broadcast, false>(lhs.nominators(), lhs.denominators(), c, d,
+                                              out.nominators(), out.denominators(), mask.data(), size);
+    }
+
+    template<Operation _Op, class T>
+    std::size_t Apply(const FractionVector<T> &lhs, const FractionVector<T> &rhs,
+                      FractionVector<T> &out, OverflowMask &mask) {
+        if (lhs.size() != rhs.size())
+            throw std::invalid_argument("FractionVector sizes differ");
+        return Apply<_Op, false>(lhs, rhs.nominators(), rhs.denominators(), out, mask);
+    }
+
+    template<Operation _Op, class T, class _Fract>
+    std::size_t Apply(const FractionVector<T> &lhs, const _Fract &rhs, FractionVector<T> &out, OverflowMask &mask) {
+        const T n = rhs.nominator();
+        const T d = rhs.denominator();
+        return Apply<_Op, true>(lhs, &n, &d, out, mask);
+    }
+}
+
+NAMESPACE_FRACTIONAL_BEGIN
+    template<class _NaturalType>
+    template<class _Fract>
+    void FractionVector<_NaturalType>::reduce() {
+        static_assert(std::is_same_v<typename _Fract::NaturalType, NaturalType>,
+                      "_Fract::NaturalType must be the lane type");
+        for (std::size_t i = 0; i < size(); ++i) {
+            normalization::Reduce<_Fract>(nominators_[i], denominators_[i]);
+        }
+    }
+
+    template<class T>
+    std::size_t add(const FractionVector<T> &lhs, const FractionVector<T> &rhs,
+                    FractionVector<T> &out, OverflowMask &mask) {
+        return simd::Apply<simd::Operation::Add>(lhs, rhs, out, mask);
+    }
+
+    template<class T>
+    std::size_t sub(const FractionVector<T> &lhs, const FractionVector<T> &rhs,
+                    FractionVector<T> &out, OverflowMask &mask) {
+        return simd::Apply<simd::Operation::Subtract>(lhs, rhs, out, mask);
+    }
+
+    template<class T>
+    std::size_t mul(const FractionVector<T> &lhs, const FractionVector<T> &rhs,
+                    FractionVector<T> &out, OverflowMask &mask) {
+        return simd::Apply<simd::Operation::Multiply>(lhs, rhs, out, mask);
+    }
+
+    template<class T>
+    std::size_t div(const FractionVector<T> &lhs, const FractionVector<T> &rhs,
+                    FractionVector<T> &out, OverflowMask &mask) {
+        return simd::Apply<simd::Operation::Divide>(lhs, rhs, out, mask);
+    }
+
+    template<class T, class _Fract, typename>
+    std::size_t add(const FractionVector<T> &lhs, const _Fract &rhs, FractionVector<T> &out, OverflowMask &mask) {
+        return simd::Apply<simd::Operation::Add>(lhs, rhs, out, mask);
+    }
+
+    template<class T, class _Fract, typename>
+    std::size_t sub(const FractionVector<T> &lhs, const _Fract &rhs, FractionVector<T> &out, OverflowMask &mask) {
+        return simd::Apply<simd::Operation::Subtract>(lhs, rhs, out, mask);
+    }
+
+    template<class T, class _Fract, typename>
+    std::size_t mul(const FractionVector<T> &lhs, const _Fract &rhs, FractionVector<T> &out, OverflowMask &mask) {
+        return simd::Apply<simd::Operation::Multiply>(lhs, rhs, out, mask);
+    }
+
+    template<class T, class _Fract, typename>
+    std::size_t div(const FractionVector<T> &lhs, const _Fract &rhs, FractionVector<T> &out, OverflowMask &mask) {
+        return simd::Apply<simd::Operation::Divide>(lhs, rhs, out, mask);
+    }
+NAMESPACE_FRACTIONAL_END
+
+#undef FRACTIONAL_ALWAYS_INLINE
+#undef FRACTIONAL_SIMD_DISPATCH
+
+#endif //FRACTIONNUMBER_FRACTIONVECTOR_HXX
@@ -0,0 +1,216 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_INSTRUMENTATION_HPP
+#define FRACTIONNUMBER_INSTRUMENTATION_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "overflowchecker.hpp"
+
+/**
+ * Operation telemetry of Fractional, recorded by the checkers of overflow::Instrumented.
+ * Every thread counts into its own slot with relaxed atomic stores, no lock is taken on
+ * the hot path. Telemetry::Collect sums the slots of live threads and the counts left by
+ * exited ones on demand.
+ *
+ * Defining FRACTIONAL_NO_INSTRUMENTATION makes Instrumented<_OverflowChecker>::OnCheck the
+ * wrapped checker itself, instrumented builds and production builds then spell the same types.
+ */
+namespace fractional::overflow {
+    struct Telemetry {
+        enum Operation : std::size_t {
+            Plus,
+            Minus,
+            Multiply,
+            Divide,
+            Negate,
+            Modulus,
+            Increment,
+            Decrement,
+            BitwiseLeftShift,
+            OperationCount
+        };
+
+        /**
+         * Buckets of the width histogram: 0 to 128 significant bits, the last one counts wider results
+         */
+        static constexpr std::size_t WidthBuckets = 130;
+
+        struct Counters {
+            /**
+             * Checks of every operation, indexed by Operation
+             */
+            std::array<std::uint64_t, OperationCount> operations{};
+
+            std::uint64_t gcd_calls = 0;
+
+            /**
+             * Loop passes of the gcd engines: shift-subtract steps of Binary,
+             * multi-precision steps of Lehmer, divisions of Euclid
+             */
+            std::uint64_t gcd_iterations = 0;
+
+            std::uint64_t lcm_calls = 0;
+
+            /**
+             * Plus and minus that took the equal denominator path
+             */
+            std::uint64_t same_denominator = 0;
+
+            /**
+             * widths[k] is the number of plus, minus, multiply and negate results
+             * whose magnitude has k significant bits
+             */
+            std::array<std::uint64_t, WidthBuckets> widths{};
+
+            Counters &operator+=(const Counters &rhs) noexcept;
+
+            Counters &operator-=(const Counters &rhs) noexcept;
+
+            /**
+             * Results within bits of the range of a type with digits value bits
+             * (std::numeric_limits::digits), these overflow once the type is bits narrower
+             */
+            std::uint64_t near_misses(std::size_t digits, std::size_t bits = 1) const noexcept;
+        };
+
+        /**
+         * Counts of all threads since the last Reset
+         */
+        static Counters Collect();
+
+        /**
+         * Starts a new measurement, counting threads are not disturbed
+         */
+        static void Reset();
+
+        static void Count(Operation operation) noexcept;
+
+        static void Width(std::size_t bits) noexcept;
+
+        static void Gcd(std::size_t iterations) noexcept;
+
+        static void Lcm() noexcept;
+
+        static void SameDenominator() noexcept;
+
+    private:
+        enum Index : std::size_t {
+            GcdCalls = OperationCount,
+            GcdIterations,
+            LcmCalls,
+            SameDenominators,
+            Widths,
+            IndexCount = Widths + WidthBuckets
+        };
+
+        /**
+         * Counters of one thread, only the owner writes them
+         */
+        struct Slot {
+            Slot();
+
+            ~Slot();
+
+            void Add(std::size_t index, std::uint64_t value) noexcept;
+
+            Counters Load() const noexcept;
+
+            std::array<std::atomic<std::uint64_t>, IndexCount> values{};
+        };
+
+        struct Registry {
+            std::mutex mutex;
+            std::vector<const Slot *> slots;
+
+            /**
+             * Counts of exited threads
+             */
+            Counters retired;
+
+            /**
+             * Collect() at the last Reset
+             */
+            Counters baseline;
+        };
+
+        static Slot &Local() noexcept;
+
+        static Registry &Shared() noexcept;
+    };
+
+    /**
+     * _OverflowChecker counting every check into Telemetry. Plus, minus, multiply and negate
+     * compute their result to record its width. Operations of widening checkers in WideType
+     * are not counted, the gcd of their results is.
+     */
+    template<template<class, template<class...> class, class...> class _OverflowChecker,
+            class _NaturalType, template<class...> class _Checker, class... _Operators>
+    struct InstrumentOnCheck : _OverflowChecker<_NaturalType, _Checker, _Operators...> {
+        using Base = _OverflowChecker<_NaturalType, _Checker, _Operators...>;
+        using NaturalType = _NaturalType;
+
+        using DivideResult = decltype(Base::CheckDivide(std::declval<const NaturalType &>(),
+                                                        std::declval<const NaturalType &>()));
+        using ModulusResult = decltype(Base::CheckModulus(std::declval<const NaturalType &>(),
+                                                          std::declval<const NaturalType &>()));
+        using IncrementResult = decltype(Base::CheckIncrement(std::declval<const NaturalType &>()));
+        using DecrementResult = decltype(Base::CheckDecrement(std::declval<const NaturalType &>()));
+        using ShiftResult = decltype(Base::CheckBitwiseLeftShift(std::declval<const NaturalType &>(), std::size_t{}));
+
+        static NaturalType CheckMultiply(const NaturalType &lhs, const NaturalType &rhs)
+        noexcept(noexcept(Base::CheckMultiply(lhs, rhs)));
+
+        static NaturalType CheckPlus(const NaturalType &lhs, const NaturalType &rhs)
+        noexcept(noexcept(Base::CheckPlus(lhs, rhs)));
+
+        static DivideResult CheckDivide(const NaturalType &lhs, const NaturalType &rhs)
+        noexcept(noexcept(Base::CheckDivide(lhs, rhs)));
+
+        static NaturalType CheckMinus(const NaturalType &lhs, const NaturalType &rhs)
+        noexcept(noexcept(Base::CheckMinus(lhs, rhs)));
+
+        static NaturalType CheckNegate(const NaturalType &lhs) noexcept(noexcept(Base::CheckNegate(lhs)));
+
+        static ModulusResult CheckModulus(const NaturalType &lhs, const NaturalType &rhs)
+        noexcept(noexcept(Base::CheckModulus(lhs, rhs)));
+
+        static IncrementResult CheckIncrement(const NaturalType &lhs) noexcept(noexcept(Base::CheckIncrement(lhs)));
+
+        static DecrementResult CheckDecrement(const NaturalType &lhs) noexcept(noexcept(Base::CheckDecrement(lhs)));
+
+        static ShiftResult CheckBitwiseLeftShift(const NaturalType &lhs, std::size_t rhs)
+        noexcept(noexcept(Base::CheckBitwiseLeftShift(lhs, rhs)));
+
+        static void OnGcd(std::size_t iterations) noexcept;
+
+        static void OnLcm() noexcept;
+
+        static void OnSameDenominator() noexcept;
+    };
+
+    /**
+     * OnCheck is the instrumented _OverflowChecker to pass to Fractional:
+     *  Fractional<int, overflow::Instrumented<overflow::ThrowOnCheck>::OnCheck>
+     */
+    template<template<class, template<class...> class, class...> class _OverflowChecker>
+    struct Instrumented {
+#ifdef FRACTIONAL_NO_INSTRUMENTATION
+        template<class _NaturalType, template<class...> class _Checker, class... _Operators>
+        using OnCheck = _OverflowChecker<_NaturalType, _Checker, _Operators...>;
+#else
+        template<class _NaturalType, template<class...> class _Checker, class... _Operators>
+        using OnCheck = InstrumentOnCheck<_OverflowChecker, _NaturalType, _Checker, _Operators...>;
+#endif
+    };
+}
+
+#include "instrumentation.hxx"
+
+#endif //FRACTIONNUMBER_INSTRUMENTATION_HPP
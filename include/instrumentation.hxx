@@ -0,0 +1,267 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_INSTRUMENTATION_HXX
+#define FRACTIONNUMBER_INSTRUMENTATION_HXX
+
+#include <algorithm>
+#include <type_traits>
+#include "instrumentation.hpp"
+
+namespace fractional::overflow {
+    inline Telemetry::Counters &Telemetry::Counters::operator+=(const Counters &rhs) noexcept {
+        for (std::size_t i = 0; i < operations.size(); ++i) {
+            operations[i] += rhs.operations[i];
+        }
+        gcd_calls += rhs.gcd_calls;
+        gcd_iterations += rhs.gcd_iterations;
+        lcm_calls += rhs.lcm_calls;
+        same_denominator += rhs.same_denominator;
+        for (std::size_t i = 0; i < widths.size(); ++i) {
+            widths[i] += rhs.widths[i];
+        }
+        return *this;
+    }
+
+    inline Telemetry::Counters &Telemetry::Counters::operator-=(const Counters &rhs) noexcept {
+        for (std::size_t i = 0; i < operations.size(); ++i) {
+            operations[i] -= rhs.operations[i];
+        }
+        gcd_calls -= rhs.gcd_calls;
+        gcd_iterations -= rhs.gcd_iterations;
+        lcm_calls -= rhs.lcm_calls;
+        same_denominator -= rhs.same_denominator;
+        for (std::size_t i = 0; i < widths.size(); ++i) {
+            widths[i] -= rhs.widths[i];
+        }
+        return *this;
+    }
+
+    inline std::uint64_t Telemetry::Counters::near_misses(std::size_t digits, std::size_t bits) const noexcept {
+        auto first = digits > bits ? digits - bits + 1 : 0;
+        std::uint64_t count = 0;
+        for (auto i = std::min(first, widths.size()); i < widths.size(); ++i) {
+            count += widths[i];
+        }
+        return count;
+    }
+
+    inline Telemetry::Slot::Slot() {
+        auto &shared = Shared();
+        std::lock_guard lock{shared.mutex};
+        shared.slots.push_back(this);
+    }
+
+    inline Telemetry::Slot::~Slot() {
+        auto &shared = Shared();
+        std::lock_guard lock{shared.mutex};
+        shared.retired += Load();
+        shared.slots.erase(std::find(shared.slots.begin(), shared.slots.end(), this));
+    }
+
+    inline void Telemetry::Slot::Add(std::size_t index, std::uint64_t value) noexcept {
+    /*
+     * Only the owner writes, a plain load and store is enough and takes no lock
+     */
+        auto &counter = values[index];
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    inline Telemetry::Counters Telemetry::Slot::Load() const noexcept {
+        Counters counters;
+        for (std::size_t i = 0; i < OperationCount; ++i) {
+            counters.operations[i] = values[i].load(std::memory_order_relaxed);
+        }
+        counters.gcd_calls = values[GcdCalls].load(std::memory_order_relaxed);
+        counters.gcd_iterations = values[GcdIterations].load(std::memory_order_relaxed);
+        counters.lcm_calls = values[LcmCalls].load(std::memory_order_relaxed);
+        counters.same_denominator = values[SameDenominators].load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < WidthBuckets; ++i) {
+            counters.widths[i] = values[Widths + i].load(std::memory_order_relaxed);
+        }
+        return counters;
+    }
+
+    inline Telemetry::Slot &Telemetry::Local() noexcept {
+        thread_local Slot slot;
+        return slot;
+    }
+
+    /**
+     * Thread-local slots are destroyed before objects with static storage, the registry outlives them
+     */
+    inline Telemetry::Registry &Telemetry::Shared() noexcept {
+        static Registry registry;
+        return registry;
+    }
+
+    inline Telemetry::Counters Telemetry::Collect() {
+        auto &shared = Shared();
+        std::lock_guard lock{shared.mutex};
+        auto counters = shared.retired;
+        for (auto slot : shared.slots) {
+            counters += slot->Load();
+        }
+        counters -= shared.baseline;
+        return counters;
+    }
+
+    inline void Telemetry::Reset() {
+        auto counters = Collect();
+        auto &shared = Shared();
+        std::lock_guard lock{shared.mutex};
+        shared.baseline += counters;
+    }
+
+    inline void Telemetry::Count(Operation operation) noexcept {
+        Local().Add(operation, 1);
+    }
+
+    inline void Telemetry::Width(std::size_t bits) noexcept {
+        Local().Add(Widths + std::min(bits, WidthBuckets - 1), 1);
+    }
+
+    inline void Telemetry::Gcd(std::size_t iterations) noexcept {
+        auto &slot = Local();
+        slot.Add(GcdCalls, 1);
+        slot.Add(GcdIterations, iterations);
+    }
+
+    inline void Telemetry::Lcm() noexcept {
+        Local().Add(LcmCalls, 1);
+    }
+
+    inline void Telemetry::SameDenominator() noexcept {
+        Local().Add(SameDenominators, 1);
+    }
+
+    namespace {
+        template<class T, typename = void>
+        struct HasBitWidth : std::false_type {
+        };
+
+        template<class T>
+        struct HasBitWidth<T, std::void_t<decltype(BitWidth(std::declval<const T &>()))>> : std::true_type {
+        };
+
+        /**
+         * Records the number of significant bits of |value|, custom types need BitWidth found by ADL
+         */
+        template<class _NaturalType>
+        void RecordWidth(const _NaturalType &value) noexcept {
+            if constexpr (std::is_integral_v<_NaturalType>) {
+                using UType = std::make_unsigned_t<_NaturalType>;
+                auto magnitude = UType(value);
+                if constexpr (std::is_signed_v<_NaturalType>) {
+                    if (value < 0)
+                        magnitude = UType(UType{} - magnitude);
+                }
+                Telemetry::Width(utility::BitWidth(magnitude));
+            } else if constexpr (HasBitWidth<_NaturalType>::value) {
+                Telemetry::Width(BitWidth(value));
+            }
+        }
+    }
+
+#define INSTRUMENT_ON_CHECK InstrumentOnCheck<_OverflowChecker, _NaturalType, _Checker, _Operators...>
+
+    template<template<class, template<class...> class, class...> class _OverflowChecker,
+            class _NaturalType, template<class...> class _Checker, class... _Operators>
+    _NaturalType INSTRUMENT_ON_CHECK::CheckMultiply(const NaturalType &lhs, const NaturalType &rhs)
+    noexcept(noexcept(Base::CheckMultiply(lhs, rhs))) {
+        Telemetry::Count(Telemetry::Multiply);
+        auto result = utility::OperatorWrapper<typename Base::MultiplyOperator, Base::CheckMultiply>{}(lhs, rhs);
+        RecordWidth(result);
+        return result;
+    }
+
+    template<template<class, template<class...> class, class...> class _OverflowChecker,
+            class _NaturalType, template<class...> class _Checker, class... _Operators>
+    _NaturalType INSTRUMENT_ON_CHECK::CheckPlus(const NaturalType &lhs, const NaturalType &rhs)
+    noexcept(noexcept(Base::CheckPlus(lhs, rhs))) {
+        Telemetry::Count(Telemetry::Plus);
+        auto result = utility::OperatorWrapper<typename Base::PlusOperator, Base::CheckPlus>{}(lhs, rhs);
+        RecordWidth(result);
+        return result;
+    }
+
+    template<template<class, template<class...> class, class...> class _OverflowChecker,
+            class _NaturalType, template<class...> class _Checker, class... _Operators>
+    typename INSTRUMENT_ON_CHECK::DivideResult INSTRUMENT_ON_CHECK::CheckDivide(const NaturalType &lhs, const NaturalType &rhs)
+    noexcept(noexcept(Base::CheckDivide(lhs, rhs))) {
+        Telemetry::Count(Telemetry::Divide);
+        return Base::CheckDivide(lhs, rhs);
+    }
+
+    template<template<class, template<class...> class, class...> class _OverflowChecker,
+            class _NaturalType, template<class...> class _Checker, class... _Operators>
+    _NaturalType INSTRUMENT_ON_CHECK::CheckMinus(const NaturalType &lhs, const NaturalType &rhs)
+    noexcept(noexcept(Base::CheckMinus(lhs, rhs))) {
+        Telemetry::Count(Telemetry::Minus);
+        auto result = utility::OperatorWrapper<typename Base::MinusOperator, Base::CheckMinus>{}(lhs, rhs);
+        RecordWidth(result);
+        return result;
+    }
+
+    template<template<class, template<class...> class, class...> class _OverflowChecker,
+            class _NaturalType, template<class...> class _Checker, class... _Operators>
+    _NaturalType INSTRUMENT_ON_CHECK::CheckNegate(const NaturalType &lhs) noexcept(noexcept(Base::CheckNegate(lhs))) {
+        Telemetry::Count(Telemetry::Negate);
+        auto result = utility::OperatorWrapper<typename Base::NegateOperator, Base::CheckNegate>{}(lhs);
+        RecordWidth(result);
+        return result;
+    }
+
+    template<template<class, template<class...> class, class...> class _OverflowChecker,
+            class _NaturalType, template<class...> class _Checker, class... _Operators>
+    typename INSTRUMENT_ON_CHECK::ModulusResult INSTRUMENT_ON_CHECK::CheckModulus(const NaturalType &lhs, const NaturalType &rhs)
+    noexcept(noexcept(Base::CheckModulus(lhs, rhs))) {
+        Telemetry::Count(Telemetry::Modulus);
+        return Base::CheckModulus(lhs, rhs);
+    }
+
+    template<template<class, template<class...> class, class...> class _OverflowChecker,
+            class _NaturalType, template<class...> class _Checker, class... _Operators>
+    typename INSTRUMENT_ON_CHECK::IncrementResult INSTRUMENT_ON_CHECK::CheckIncrement(const NaturalType &lhs) noexcept(noexcept(Base::CheckIncrement(lhs))) {
+        Telemetry::Count(Telemetry::Increment);
+        return Base::CheckIncrement(lhs);
+    }
+
+    template<template<class, template<class...> class, class...> class _OverflowChecker,
+            class _NaturalType, template<class...> class _Checker, class... _Operators>
+    typename INSTRUMENT_ON_CHECK::DecrementResult INSTRUMENT_ON_CHECK::CheckDecrement(const NaturalType &lhs) noexcept(noexcept(Base::CheckDecrement(lhs))) {
+        Telemetry::Count(Telemetry::Decrement);
+        return Base::CheckDecrement(lhs);
+    }
+
+    template<template<class, template<class...> class, class...> class _OverflowChecker,
+            class _NaturalType, template<class...> class _Checker, class... _Operators>
+    typename INSTRUMENT_ON_CHECK::ShiftResult INSTRUMENT_ON_CHECK::CheckBitwiseLeftShift(const NaturalType &lhs, std::size_t rhs)
+    noexcept(noexcept(Base::CheckBitwiseLeftShift(lhs, rhs))) {
+        Telemetry::Count(Telemetry::BitwiseLeftShift);
+        return Base::CheckBitwiseLeftShift(lhs, rhs);
+    }
+
+    template<template<class, template<class...> class, class...> class _OverflowChecker,
+            class _NaturalType, template<class...> class _Checker, class... _Operators>
+    void INSTRUMENT_ON_CHECK::OnGcd(std::size_t iterations) noexcept {
+        Telemetry::Gcd(iterations);
+    }
+
+    template<template<class, template<class...> class, class...> class _OverflowChecker,
+            class _NaturalType, template<class...> class _Checker, class... _Operators>
+    void INSTRUMENT_ON_CHECK::OnLcm() noexcept {
+        Telemetry::Lcm();
+    }
+
+    template<template<class, template<class...> class, class...> class _OverflowChecker,
+            class _NaturalType, template<class...> class _Checker, class... _Operators>
+    void INSTRUMENT_ON_CHECK::OnSameDenominator() noexcept {
+        Telemetry::SameDenominator();
+    }
+
+#undef INSTRUMENT_ON_CHECK
+}
+
+#endif //FRACTIONNUMBER_INSTRUMENTATION_HXX
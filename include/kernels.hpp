@@ -0,0 +1,42 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_KERNELS_HPP
+#define FRACTIONNUMBER_KERNELS_HPP
+
+#include <cstddef>
+#include "fractional.hpp"
+
+/**
+ * Polynomial and dot product kernels with delayed reduction. One running nominator/denominator
+ * pair is kept in the wider built-in integer of NaturalType, or in NaturalType itself when there
+ * is none, and each step is a few plain multiplications and additions without gcd. The pair is
+ * reduced only when the next step would not fit, or for unbounded NaturalType when it grows past
+ * KernelReduceBits, and once at the end. A step that still does not fit after reduction is done
+ * with the scalar Fractional operations, so overflow is reported by the checker of the type
+ * exactly where the scalar loop would report it.
+ */
+NAMESPACE_FRACTIONAL_BEGIN
+    /**
+     * Bit length of a running nominator or denominator of unbounded NaturalType that triggers reduction
+     */
+    constexpr std::size_t KernelReduceBits = 2048;
+
+    /**
+     * coefficients[0] + coefficients[1] * x + ... + coefficients[n - 1] * x^(n - 1), zero for no coefficients
+     */
+    template<class _Container>
+    constexpr typename _Container::value_type
+    horner(const _Container &coefficients, const typename _Container::value_type &x);
+
+    /**
+     * Sum of lhs[i] * rhs[i], lhs and rhs have the same size
+     */
+    template<class _Container1, class _Container2>
+    constexpr typename _Container1::value_type dot(const _Container1 &lhs, const _Container2 &rhs);
+NAMESPACE_FRACTIONAL_END
+
+#include "kernels.hxx"
+
+#endif //FRACTIONNUMBER_KERNELS_HPP
@@ -0,0 +1,241 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_KERNELS_HXX
+#define FRACTIONNUMBER_KERNELS_HXX
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include "kernels.hpp"
+
+NAMESPACE_FRACTIONAL_BEGIN
+    namespace {
+        /**
+         * Type of the running pair: the wider built-in integer of _NaturalType, _NaturalType without one
+         */
+        template<class _NaturalType, typename = void>
+        struct KernelWide {
+            using type = _NaturalType;
+        };
+
+        template<class _NaturalType>
+        struct KernelWide<_NaturalType, std::enable_if_t<utility::HasWider<_NaturalType>::value>> {
+            using type = utility::WiderType<_NaturalType>;
+        };
+
+        /**
+         * Number of significant bits of |value|, BitWidth of unbounded types is found through ADL
+         */
+        template<class _Type>
+        constexpr std::size_t Bits(const _Type &value) noexcept {
+            if constexpr (std::is_integral_v<_Type>) {
+                return utility::BitWidth(Magnitude(value));
+            } else {
+                return BitWidth(value);
+            }
+        }
+
+        /**
+         * value as _Fract::NaturalType. A value out of range is passed to Checker::CheckMultiply as a
+         * product that overflows for sure, so the checker reports it like any other overflow.
+         */
+        template<class _Fract, class _Wide>
+        constexpr typename _Fract::NaturalType NarrowChecked(const _Wide &value) {
+            using NaturalType = typename _Fract::NaturalType;
+            using Limits = std::numeric_limits<NaturalType>;
+
+            if (value < _Wide(Limits::lowest()) || value > _Wide(Limits::max())) {
+                _Fract::Checker::CheckMultiply(IsNegative(value) ? Limits::lowest() : Limits::max(), NaturalType(2));
+            }
+            return NaturalType(value);
+        }
+
+        /**
+         * Running nominator/denominator pair of Wide, reduced only when the next step would not fit
+         */
+        template<class _Fract>
+        class DelayedFraction {
+        public:
+            using NaturalType = typename _Fract::NaturalType;
+            using Wide = typename KernelWide<NaturalType>::type;
+
+            static constexpr bool IsBounded = std::numeric_limits<Wide>::is_bounded;
+
+            constexpr DelayedFraction(Wide nominator, Wide denominator)
+                    : nominator_(std::move(nominator)), denominator_(std::move(denominator)) {}
+
+            /**
+             * *this *= nominator/denominator
+             */
+            constexpr void multiply(Wide nominator, Wide denominator) {
+                if (!Fits(nominator_, nominator) || !Fits(denominator_, denominator)) {
+                    Reduce(nominator_, denominator_);
+                    Reduce(nominator, denominator);
+                    if (!Fits(nominator_, nominator) || !Fits(denominator_, denominator)) {
+                        if constexpr (IsBounded) {
+                            Assign(Scalar(nominator_, denominator_) * Scalar(nominator, denominator));
+                            return;
+                        }
+                    }
+                }
+                nominator_ = nominator_ * nominator;
+                denominator_ = denominator_ * denominator;
+            }
+
+            /**
+             * *this += nominator/denominator
+             */
+            constexpr void add(Wide nominator, Wide denominator) {
+                if (denominator_ == denominator && FitsSum(nominator_, nominator)) {
+                    nominator_ = nominator_ + nominator;
+                    return;
+                }
+                if (!FitsAdd(nominator, denominator)) {
+                    Reduce(nominator_, denominator_);
+                    Reduce(nominator, denominator);
+                    if (!FitsAdd(nominator, denominator)) {
+                        if constexpr (IsBounded) {
+                            Assign(Scalar(nominator_, denominator_) + Scalar(nominator, denominator));
+                            return;
+                        }
+                    }
+                }
+                nominator_ = nominator_ * denominator + nominator * denominator_;
+                denominator_ = denominator_ * denominator;
+            }
+
+            /**
+             * *this += lhs * rhs
+             */
+            constexpr void add_product(const _Fract &lhs, const _Fract &rhs) {
+                Wide lhs_n(lhs.nominator()), lhs_d(lhs.denominator());
+                Wide rhs_n(rhs.nominator()), rhs_d(rhs.denominator());
+                if (!Fits(lhs_n, rhs_n) || !Fits(lhs_d, rhs_d)) {
+                    if constexpr (IsBounded) {
+                        auto product = lhs * rhs;
+                        add(Wide(product.nominator()), Wide(product.denominator()));
+                        return;
+                    }
+                }
+                add(lhs_n * rhs_n, lhs_d * rhs_d);
+            }
+
+            constexpr _Fract result() {
+                if (!_Fract::Normalization::IsCanonical || !InRange(nominator_) || !InRange(denominator_)) {
+                    Reduce(nominator_, denominator_);
+                }
+                return Scalar(nominator_, denominator_);
+            }
+
+        private:
+            /**
+             * A product of lhs and rhs fits with a bit to spare, so a sum of two such products fits too.
+             * Unbounded Wide fits below KernelReduceBits.
+             */
+            static constexpr bool Fits(const Wide &lhs, const Wide &rhs) noexcept {
+                if constexpr (IsBounded) {
+                    return Bits(lhs) + Bits(rhs) < std::size_t(std::numeric_limits<Wide>::digits);
+                } else {
+                    return Bits(lhs) + Bits(rhs) <= KernelReduceBits;
+                }
+            }
+
+            static constexpr bool FitsSum(const Wide &lhs, const Wide &rhs) noexcept {
+                if constexpr (IsBounded) {
+                    return std::max(Bits(lhs), Bits(rhs)) < std::size_t(std::numeric_limits<Wide>::digits);
+                } else {
+                    return true;
+                }
+            }
+
+            constexpr bool FitsAdd(const Wide &nominator, const Wide &denominator) const noexcept {
+                return Fits(nominator_, denominator) && Fits(nominator, denominator_) &&
+                       Fits(denominator_, denominator);
+            }
+
+            static constexpr bool InRange(const Wide &value) noexcept {
+                if constexpr (std::is_same_v<Wide, NaturalType>) {
+                    return true;
+                } else {
+                    return value >= Wide(std::numeric_limits<NaturalType>::lowest()) &&
+                           value <= Wide(std::numeric_limits<NaturalType>::max());
+                }
+            }
+
+            static constexpr void Reduce(Wide &nominator, Wide &denominator) {
+                if constexpr (std::is_same_v<Wide, NaturalType>) {
+                    normalization::Reduce<_Fract>(nominator, denominator);
+                } else {
+                    auto gcd = std::gcd(nominator, denominator);
+                    if (gcd > 1) {
+                        nominator /= gcd;
+                        denominator /= gcd;
+                    }
+                }
+            }
+
+            /**
+             * nominator/denominator as _Fract, out of range values are reported by the checker
+             */
+            static constexpr _Fract Scalar(const Wide &nominator, const Wide &denominator) {
+                if constexpr (std::is_same_v<Wide, NaturalType>) {
+                    return _Fract(nominator, denominator);
+                } else {
+                    return _Fract(NarrowChecked<_Fract>(nominator), NarrowChecked<_Fract>(denominator));
+                }
+            }
+
+            constexpr void Assign(const _Fract &value) {
+                nominator_ = Wide(value.nominator());
+                denominator_ = Wide(value.denominator());
+            }
+
+            Wide nominator_;
+            Wide denominator_;
+        };
+    }
+
+    template<class _Container>
+    constexpr typename _Container::value_type
+    horner(const _Container &coefficients, const typename _Container::value_type &x) {
+        using Fract = typename _Container::value_type;
+        using NaturalType = typename Fract::NaturalType;
+        using Wide = typename DelayedFraction<Fract>::Wide;
+
+        auto size = std::size(coefficients);
+        if (size == 0)
+            return Fract(NaturalType{}, utility::One<NaturalType>());
+
+        const auto &leading = coefficients[size - 1];
+        DelayedFraction<Fract> value{Wide(leading.nominator()), Wide(leading.denominator())};
+        for (auto i = size - 1; i-- > 0;) {
+            value.multiply(Wide(x.nominator()), Wide(x.denominator()));
+            value.add(Wide(coefficients[i].nominator()), Wide(coefficients[i].denominator()));
+        }
+        return value.result();
+    }
+
+    template<class _Container1, class _Container2>
+    constexpr typename _Container1::value_type dot(const _Container1 &lhs, const _Container2 &rhs) {
+        using Fract = typename _Container1::value_type;
+        using NaturalType = typename Fract::NaturalType;
+        using Wide = typename DelayedFraction<Fract>::Wide;
+        static_assert(std::is_same_v<Fract, typename _Container2::value_type>, "lhs and rhs hold different types");
+
+        auto size = std::size(lhs);
+        assert(size == std::size(rhs));
+        DelayedFraction<Fract> sum{Wide(NaturalType{}), Wide(utility::One<NaturalType>())};
+        for (std::size_t i = 0; i < size; ++i) {
+            sum.add_product(lhs[i], rhs[i]);
+        }
+        return sum.result();
+    }
+NAMESPACE_FRACTIONAL_END
+
+#endif //FRACTIONNUMBER_KERNELS_HXX
@@ -0,0 +1,102 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_MATRIX_HPP
+#define FRACTIONNUMBER_MATRIX_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <optional>
+#include <vector>
+#include "fractional.hpp"
+
+/**
+ * Exact dense linear algebra over Fractional. Every row is scaled by the lcm of its
+ * denominators into integers, which are eliminated by Bareiss' fraction-free algorithm:
+ * each step divides exactly by the previous pivot, so entries stay minors of the scaled
+ * matrix instead of growing like the fractions of naive Gaussian elimination.
+ * With built-in NaturalType products of entries are formed in utility::WiderType and
+ * a result out of range is reported through the checker of the Fractional: throwing
+ * checkers throw overflow::OverflowUnaryError<WiderType> for a quotient out of NaturalType
+ * range, the others keep the value wrapped and FlagOnCheck raises OverflowFlags::Multiply.
+ * Other NaturalType go through the checked operators of the Fractional.
+ * NaturalType must be signed.
+ */
+NAMESPACE_FRACTIONAL_BEGIN
+    /**
+     * Row-major rows() x cols() matrix
+     */
+    template<class _Fract>
+    class Matrix {
+    public:
+        using ValueType = _Fract;
+
+        /**
+         * Zero matrix
+         */
+        Matrix(std::size_t rows, std::size_t cols);
+
+        /**
+         * Matrix from its rows, which must have the same size
+         */
+        Matrix(std::initializer_list<std::initializer_list<_Fract>> rows);
+
+        std::size_t rows() const noexcept;
+
+        std::size_t cols() const noexcept;
+
+        _Fract &operator()(std::size_t row, std::size_t col) noexcept;
+
+        const _Fract &operator()(std::size_t row, std::size_t col) const noexcept;
+
+    private:
+        std::size_t rows_;
+        std::size_t cols_;
+        std::vector<_Fract> values_;
+    };
+
+    struct EliminationOptions {
+        /**
+         * Worker threads including the caller, 0 for std::thread::hardware_concurrency
+         */
+        std::size_t threads = 0;
+
+        /**
+         * Columns updated per pass over the rows, keeps the pivot row segment in cache
+         */
+        std::size_t block = 64;
+
+        /**
+         * Rows per chunk, a chunk is the unit of work of a thread
+         */
+        std::size_t grain = 16;
+
+        /**
+         * Elimination steps updating fewer entries run on the calling thread
+         */
+        std::size_t parallel_threshold = 1u << 14u;
+    };
+
+    /**
+     * Determinant of a square matrix, std::invalid_argument for any other
+     */
+    template<class _Fract>
+    _Fract determinant(const Matrix<_Fract> &matrix, const EliminationOptions &options = {});
+
+    template<class _Fract>
+    std::size_t rank(const Matrix<_Fract> &matrix, const EliminationOptions &options = {});
+
+    /**
+     * x with matrix * x == rhs for a square matrix, std::invalid_argument for any other
+     * or for rhs of a different size
+     * @return nullopt if the matrix is singular
+     */
+    template<class _Fract>
+    std::optional<std::vector<_Fract>> solve(const Matrix<_Fract> &matrix, const std::vector<_Fract> &rhs,
+                                             const EliminationOptions &options = {});
+NAMESPACE_FRACTIONAL_END
+
+#include "matrix.hxx"
+
+#endif //FRACTIONNUMBER_MATRIX_HPP
@@ -0,0 +1,345 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_MATRIX_HXX
+#define FRACTIONNUMBER_MATRIX_HXX
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "matrix.hpp"
+#include "parallel.hpp"
+
+NAMESPACE_FRACTIONAL_BEGIN
+    template<class _Fract>
+    Matrix<_Fract>::Matrix(std::size_t rows, std::size_t cols)
+            : rows_(rows), cols_(cols),
+              values_(rows * cols, _Fract{typename _Fract::NaturalType{},
+                                          utility::One<typename _Fract::NaturalType>()}) {}
+
+    template<class _Fract>
+    Matrix<_Fract>::Matrix(std::initializer_list<std::initializer_list<_Fract>> rows)
+            : rows_(rows.size()), cols_(rows.size() > 0 ? rows.begin()->size() : 0) {
+        values_.reserve(rows_ * cols_);
+        for (auto &row : rows) {
+            if (row.size() != cols_)
+                throw std::invalid_argument("Matrix rows differ in size");
+            values_.insert(values_.end(), row.begin(), row.end());
+        }
+    }
+
+    template<class _Fract>
+    std::size_t Matrix<_Fract>::rows() const noexcept {
+        return rows_;
+    }
+
+    template<class _Fract>
+    std::size_t Matrix<_Fract>::cols() const noexcept {
+        return cols_;
+    }
+
+    template<class _Fract>
+    _Fract &Matrix<_Fract>::operator()(std::size_t row, std::size_t col) noexcept {
+        return values_[row * cols_ + col];
+    }
+
+    template<class _Fract>
+    const _Fract &Matrix<_Fract>::operator()(std::size_t row, std::size_t col) const noexcept {
+        return values_[row * cols_ + col];
+    }
+
+    namespace {
+        /**
+         * Integer operations of the elimination, see the module description
+         */
+        template<class _Fract>
+        struct BareissArithmetic {
+            using Integer = typename _Fract::NaturalType;
+
+            static_assert(std::numeric_limits<Integer>::is_signed, "Bareiss elimination requires signed NaturalType");
+
+            static constexpr bool IsWide = std::is_integral_v<Integer> && utility::HasWider<Integer>::value;
+
+            using Wide = typename std::conditional_t<IsWide, utility::Wider<Integer>,
+                    std::enable_if<true, Integer>>::type;
+
+            /**
+             * Reports a wide result out of range: throwing checkers throw _Error, the others get a
+             * product that overflows for sure, so FlagOnCheck raises OverflowFlags::Multiply
+             */
+            template<class _Error, class... _Operands>
+            static void ReportOverflow(const _Operands &... operands) {
+                using Checker = typename _Fract::Checker;
+                if constexpr (noexcept(Checker::CheckMultiply(std::declval<const Integer &>(),
+                                                              std::declval<const Integer &>()))) {
+                    Checker::CheckMultiply(std::numeric_limits<Integer>::max(), Integer(2));
+                } else {
+                    throw _Error(operands...);
+                }
+            }
+
+            static bool IsZero(const Integer &value) {
+                return typename _Fract::EqualOperator{}(value, Integer{});
+            }
+
+            static Wide Product(const Integer &lhs, const Integer &rhs) {
+                if constexpr (IsWide) {
+                    return Wide(lhs) * Wide(rhs);
+                } else {
+                    return typename _Fract::MultiplyOperator{}(lhs, rhs);
+                }
+            }
+
+            static Wide Difference(const Wide &lhs, const Wide &rhs) {
+                if constexpr (IsWide) {
+                    Wide result{};
+                    if (__builtin_sub_overflow(lhs, rhs, &result))
+                        ReportOverflow<overflow::OverflowBinaryError<Wide, Wide>>(lhs, rhs);
+                    return result;
+                } else {
+                    return typename _Fract::MinusOperator{}(lhs, rhs);
+                }
+            }
+
+            /**
+             * lhs / rhs narrowed to Integer, the division is exact
+             */
+            static Integer Quotient(const Wide &lhs, const Integer &rhs) {
+                if constexpr (IsWide) {
+    /*
+     * Division in Integer is much cheaper than in Wide when __int128 is emulated
+     */
+                    if (Wide(Integer(lhs)) == lhs && rhs != Integer(-1))
+                        return Integer(Integer(lhs) / rhs);
+                    auto result = Wide(lhs / Wide(rhs));
+                    if (Wide(Integer(result)) != result)
+                        ReportOverflow<overflow::OverflowUnaryError<Wide>>(result);
+                    return Integer(result);
+                } else {
+                    return typename _Fract::DivideOperator{}(lhs, rhs);
+                }
+            }
+
+            /**
+             * Bareiss step (pivot * entry - factor * pivot_entry) / previous
+             */
+            static Integer Update(const Integer &pivot, const Integer &entry, const Integer &factor,
+                                  const Integer &pivot_entry, const Integer &previous) {
+                return Quotient(Difference(Product(pivot, entry), Product(factor, pivot_entry)), previous);
+            }
+        };
+
+        template<class _Fract>
+        struct ScaledMatrix {
+            using Integer = typename _Fract::NaturalType;
+
+            Integer *row(std::size_t index) noexcept {
+                return values.data() + index * cols;
+            }
+
+            std::size_t rows;
+            std::size_t cols;
+            std::vector<Integer> values;
+
+            /**
+             * Row i of values is row i of the source times scales[i]
+             */
+            std::vector<Integer> scales;
+        };
+
+        /**
+         * Integer matrix of matrix with rhs appended as the last column, if any.
+         * Every row is multiplied by the lcm of its denominators.
+         */
+        template<class _Fract>
+        ScaledMatrix<_Fract> ScaleRows(const Matrix<_Fract> &matrix, const std::vector<_Fract> *rhs) {
+            using Integer = typename _Fract::NaturalType;
+            using Checker = typename _Fract::Checker;
+            using Multiply = typename _Fract::MultiplyOperator;
+            using Divide = typename _Fract::DivideOperator;
+
+            auto cols = matrix.cols() + (rhs ? 1 : 0);
+            ScaledMatrix<_Fract> scaled{matrix.rows(), cols, {}, {}};
+            scaled.values.reserve(matrix.rows() * cols);
+            scaled.scales.reserve(matrix.rows());
+
+            std::vector<Integer> denominators(cols);
+            for (std::size_t row = 0; row < matrix.rows(); ++row) {
+                auto first = scaled.values.size();
+                auto scale = utility::One<Integer>();
+                for (std::size_t col = 0; col < cols; ++col) {
+                    auto &value = col < matrix.cols() ? matrix(row, col) : (*rhs)[row];
+                    Integer nominator = value.nominator();
+                    Integer denominator = value.denominator();
+                    if constexpr (!_Fract::Normalization::IsCanonical) {
+                        normalization::Reduce<_Fract>(nominator, denominator);
+                    }
+                    scale = utility::lcm<Integer, Checker>(scale, denominator);
+                    scaled.values.push_back(std::move(nominator));
+                    denominators[col] = std::move(denominator);
+                }
+                for (std::size_t col = 0; col < cols; ++col) {
+                    auto &entry = scaled.values[first + col];
+                    entry = Multiply{}(entry, Divide{}(scale, denominators[col]));
+                }
+                scaled.scales.push_back(std::move(scale));
+            }
+            return scaled;
+        }
+
+        struct Elimination {
+            std::size_t rank;
+
+            /**
+             * Odd number of row swaps
+             */
+            bool negated;
+        };
+
+        /**
+         * Bareiss fraction-free elimination to row echelon form, pivots are searched in the first
+         * pivot_cols columns. A column without a pivot is skipped, the divisor stays the last pivot.
+         * After the step of pivot k every entry below and right of it is a (k + 2)-minor of the input.
+         */
+        template<class _Fract>
+        Elimination Eliminate(ScaledMatrix<_Fract> &matrix, std::size_t pivot_cols, const EliminationOptions &options) {
+            using Integer = typename _Fract::NaturalType;
+            using Arithmetic = BareissArithmetic<_Fract>;
+
+            auto block = std::max<std::size_t>(1, options.block);
+            auto grain = std::max<std::size_t>(1, options.grain);
+            auto rows = matrix.rows;
+            auto cols = matrix.cols;
+
+            auto previous = utility::One<Integer>();
+            Elimination result{0, false};
+            for (std::size_t col = 0; col < pivot_cols && result.rank < rows; ++col) {
+                auto found = result.rank;
+                while (found < rows && Arithmetic::IsZero(matrix.row(found)[col])) {
+                    ++found;
+                }
+                if (found == rows)
+                    continue;
+                if (found != result.rank) {
+                    std::swap_ranges(matrix.row(found), matrix.row(found) + cols, matrix.row(result.rank));
+                    result.negated = !result.negated;
+                }
+
+                auto pivot = matrix.row(result.rank);
+                auto first = result.rank + 1;
+    /*
+     * Rows [begin, end) are updated one block of columns at a time, so the pivot row segment
+     * stays in cache while it is read once per row. The factor column is cleared last.
+     */
+                auto update = [&](std::size_t begin, std::size_t end) {
+                    for (auto start = col + 1; start < cols; start += block) {
+                        auto stop = std::min(cols, start + block);
+                        for (auto row = begin; row < end; ++row) {
+                            auto current = matrix.row(row);
+                            for (auto entry = start; entry < stop; ++entry) {
+                                current[entry] = Arithmetic::Update(pivot[col], current[entry], current[col],
+                                                                    pivot[entry], previous);
+                            }
+                        }
+                    }
+                    for (auto row = begin; row < end; ++row) {
+                        matrix.row(row)[col] = Integer{};
+                    }
+                };
+
+                auto below = rows - first;
+                if (options.threads == 1 || below * (cols - col) < options.parallel_threshold) {
+                    update(first, rows);
+                } else {
+                    ParallelFor((below + grain - 1) / grain, options.threads, [&](std::size_t chunk) {
+                        auto begin = first + chunk * grain;
+                        update(begin, std::min(rows, begin + grain));
+                    });
+                }
+                previous = pivot[col];
+                ++result.rank;
+            }
+            return result;
+        }
+    }
+
+    template<class _Fract>
+    _Fract determinant(const Matrix<_Fract> &matrix, const EliminationOptions &options) {
+        using NaturalType = typename _Fract::NaturalType;
+        using Negate = typename _Fract::NegateOperator;
+
+        if (matrix.rows() != matrix.cols())
+            throw std::invalid_argument("Matrix is not square");
+        auto size = matrix.rows();
+        if (size == 0)
+            return _Fract{utility::One<NaturalType>(), utility::One<NaturalType>()};
+
+        auto scaled = ScaleRows<_Fract>(matrix, nullptr);
+        auto [rank, negated] = Eliminate(scaled, size, options);
+        if (rank < size)
+            return _Fract{NaturalType{}, utility::One<NaturalType>()};
+
+    /*
+     * The last pivot is the determinant of the scaled matrix
+     */
+        auto pivot = scaled.row(size - 1)[size - 1];
+        if (negated) {
+            pivot = Negate{}(pivot);
+        }
+        _Fract result{pivot, utility::One<NaturalType>()};
+        for (auto &scale : scaled.scales) {
+            result /= _Fract{scale, utility::One<NaturalType>()};
+        }
+        return result;
+    }
+
+    template<class _Fract>
+    std::size_t rank(const Matrix<_Fract> &matrix, const EliminationOptions &options) {
+        auto scaled = ScaleRows<_Fract>(matrix, nullptr);
+        return Eliminate(scaled, matrix.cols(), options).rank;
+    }
+
+    template<class _Fract>
+    std::optional<std::vector<_Fract>> solve(const Matrix<_Fract> &matrix, const std::vector<_Fract> &rhs,
+                                             const EliminationOptions &options) {
+        using NaturalType = typename _Fract::NaturalType;
+        using Arithmetic = BareissArithmetic<_Fract>;
+
+        if (matrix.rows() != matrix.cols())
+            throw std::invalid_argument("Matrix is not square");
+        if (rhs.size() != matrix.rows())
+            throw std::invalid_argument("Matrix and right-hand side sizes differ");
+        auto size = matrix.rows();
+
+        auto scaled = ScaleRows<_Fract>(matrix, &rhs);
+        if (Eliminate(scaled, size, options).rank < size)
+            return std::nullopt;
+
+    /*
+     * Fraction-free back substitution: x[i] = y[i] / det, every y[i] is the determinant
+     * of the scaled matrix with column i replaced by the right-hand side, so divisions are exact
+     */
+        std::vector<NaturalType> numerators(size);
+        auto det = size > 0 ? scaled.row(size - 1)[size - 1] : utility::One<NaturalType>();
+        for (auto i = size; i-- > 0;) {
+            auto current = scaled.row(i);
+            auto sum = Arithmetic::Product(det, current[size]);
+            for (auto j = i + 1; j < size; ++j) {
+                sum = Arithmetic::Difference(sum, Arithmetic::Product(current[j], numerators[j]));
+            }
+            numerators[i] = Arithmetic::Quotient(sum, current[i]);
+        }
+
+        std::vector<_Fract> result;
+        result.reserve(size);
+        for (auto &numerator : numerators) {
+            result.emplace_back(numerator, det);
+        }
+        return result;
+    }
+NAMESPACE_FRACTIONAL_END
+
+#endif //FRACTIONNUMBER_MATRIX_HXX
@@ -0,0 +1,165 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_NORMALIZATION_HPP
+#define FRACTIONNUMBER_NORMALIZATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include "utility.hpp"
+
+/**
+ * Normalization policies decide when Fractional brings nominator/denominator to canonical form:
+ * positive denominator and gcd(nominator, denominator) == 1.
+ * Each policy provides
+ *  IsCanonical - every stored value is canonical, equal values have equal members
+ *  OnResult<Fract>(n, d) - called after construction and after every arithmetic operation
+ *  OnRead<Fract>(n, d) - called on copies of the members before comparison and output
+ */
+namespace fractional::normalization {
+    /**
+     * Brings n/d to canonical form: denominator > 0, gcd(n, d) == 1
+     */
+    template<class _Fract>
+    constexpr void Reduce(typename _Fract::NaturalType &nominator, typename _Fract::NaturalType &denominator) {
+        using NaturalType = typename _Fract::NaturalType;
+        using Divide = typename _Fract::DivideOperator;
+        using Negate = typename _Fract::NegateOperator;
+        using Equals = typename _Fract::EqualOperator;
+        using Less = typename _Fract::LessOperator;
+
+        if (Less{}(denominator, NaturalType{})) {
+            nominator = Negate{}(nominator);
+            denominator = Negate{}(denominator);
+        }
+
+        auto gcd = utility::gcd<NaturalType, typename _Fract::Checker>(nominator, denominator);
+        if (Less{}(gcd, NaturalType{})) {
+            gcd = Negate{}(gcd);
+        }
+        if (Equals{}(gcd, NaturalType{}) || Equals{}(gcd, utility::One<NaturalType>())) {
+            return;
+        }
+        nominator = Divide{}(nominator, gcd);
+        denominator = Divide{}(denominator, gcd);
+    }
+
+    /**
+     * Always canonical, pays one gcd per operation
+     */
+    struct Eager {
+        static constexpr bool IsCanonical = true;
+
+        template<class _Fract>
+        static constexpr void
+        OnResult(typename _Fract::NaturalType &nominator, typename _Fract::NaturalType &denominator) {
+            Reduce<_Fract>(nominator, denominator);
+        }
+
+        template<class _Fract>
+        static constexpr void
+        OnRead(typename _Fract::NaturalType &, typename _Fract::NaturalType &) noexcept {}
+    };
+
+    /**
+     * Reduces only when nominator or denominator magnitude needs more than
+     * _ThresholdPercent percent of NaturalType digits, and before comparison/output.
+     * Unbounded NaturalType is measured against the digits of std::int64_t.
+     */
+    template<std::size_t _ThresholdPercent = 50>
+    struct Lazy {
+        static_assert(_ThresholdPercent > 0 && _ThresholdPercent < 100,
+                      "_ThresholdPercent must be in (0, 100)");
+
+        static constexpr bool IsCanonical = false;
+
+        template<class _NaturalType>
+        static constexpr _NaturalType Threshold() {
+            auto threshold = utility::One<_NaturalType>();
+            using limits = std::numeric_limits<_NaturalType>;
+            constexpr auto digits = limits::is_bounded ? limits::digits : std::numeric_limits<std::int64_t>::digits;
+            auto bits = std::size_t(digits) * _ThresholdPercent / 100;
+            for (std::size_t i = 0; i < bits; ++i) {
+                threshold = threshold + threshold;
+            }
+            return threshold;
+        }
+
+        /**
+         * Threshold and its negation, computed on first use for types that are not built-in
+         */
+        template<class _NaturalType>
+        static const std::pair<_NaturalType, _NaturalType> &Bounds() {
+            static const auto bounds = [] {
+                auto threshold = Threshold<_NaturalType>();
+                if constexpr (std::numeric_limits<_NaturalType>::is_signed) {
+                    auto negative = -threshold;
+                    return std::pair<_NaturalType, _NaturalType>(std::move(threshold), std::move(negative));
+                } else {
+                    return std::pair<_NaturalType, _NaturalType>(threshold, threshold);
+                }
+            }();
+            return bounds;
+        }
+
+        template<class _Fract>
+        static constexpr bool IsLarge(const typename _Fract::NaturalType &value) {
+            using NaturalType = typename _Fract::NaturalType;
+            using Less = typename _Fract::LessOperator;
+            using Greater = typename _Fract::GreaterOperator;
+
+            if constexpr (std::is_integral_v<NaturalType>) {
+                constexpr auto threshold = Threshold<NaturalType>();
+                if (Greater{}(value, threshold))
+                    return true;
+                if constexpr (std::numeric_limits<NaturalType>::is_signed) {
+                    return Less{}(value, NaturalType(-threshold));
+                }
+                return false;
+            } else {
+                const auto &[threshold, negative] = Bounds<NaturalType>();
+                if (Greater{}(value, threshold))
+                    return true;
+                if constexpr (std::numeric_limits<NaturalType>::is_signed) {
+                    return Less{}(value, negative);
+                }
+                return false;
+            }
+        }
+
+        template<class _Fract>
+        static constexpr void
+        OnResult(typename _Fract::NaturalType &nominator, typename _Fract::NaturalType &denominator) {
+            if (IsLarge<_Fract>(nominator) || IsLarge<_Fract>(denominator)) {
+                Reduce<_Fract>(nominator, denominator);
+            }
+        }
+
+        template<class _Fract>
+        static constexpr void
+        OnRead(typename _Fract::NaturalType &nominator, typename _Fract::NaturalType &denominator) {
+            Reduce<_Fract>(nominator, denominator);
+        }
+    };
+
+    /**
+     * Never reduces, values are kept as computed
+     */
+    struct None {
+        static constexpr bool IsCanonical = false;
+
+        template<class _Fract>
+        static constexpr void
+        OnResult(typename _Fract::NaturalType &, typename _Fract::NaturalType &) noexcept {}
+
+        template<class _Fract>
+        static constexpr void
+        OnRead(typename _Fract::NaturalType &, typename _Fract::NaturalType &) noexcept {}
+    };
+}
+
+#endif //FRACTIONNUMBER_NORMALIZATION_HPP
@@ -6,8 +6,11 @@
 #define FRACTIONNUMBER_OVERFLOWCHECKER_HPP
 
 #include <functional>
+#include <cassert>
 #include <exception>
+#include <limits>
 #include <string>
+#include "utility.hpp"
 
 #define DECLARATION_TEMPLATE_PARAMS \
 class _EqualOperator,\
@@ -203,6 +206,10 @@ namespace fractional::overflow {
         static constexpr bool CheckBitwiseLeftShift(const NaturalType &lhs, std::size_t rhs);
     };
 
+    /**
+     * Throws BinaryError, BitwiseError or UnaryError on overflow. Checks are constexpr:
+     * overflow during constant evaluation reaches the throw and fails compilation.
+     */
     template<class _NaturalType, template<class...> class _Checker = IntegralCheckOverflow, DECLARATION_DEFAULT_TEMPLATE_PARAMS >
     struct ThrowOnCheck {
         using NaturalType = _NaturalType;
@@ -226,23 +233,23 @@ namespace fractional::overflow {
         using LessOperator = _LessOperator;
         using LessEqualOperator = _LessEqualOperator;
 
-        static void CheckMultiply(const NaturalType &lhs, const NaturalType &rhs);
+        static constexpr void CheckMultiply(const NaturalType &lhs, const NaturalType &rhs);
 
-        static void CheckPlus(const NaturalType &lhs, const NaturalType &rhs);
+        static constexpr void CheckPlus(const NaturalType &lhs, const NaturalType &rhs);
 
-        static void CheckDivide(const NaturalType &lhs, const NaturalType &rhs);
+        static constexpr void CheckDivide(const NaturalType &lhs, const NaturalType &rhs);
 
-        static void CheckMinus(const NaturalType &lhs, const NaturalType &rhs);
+        static constexpr void CheckMinus(const NaturalType &lhs, const NaturalType &rhs);
 
-        static void CheckNegate(const NaturalType &lhs);
+        static constexpr void CheckNegate(const NaturalType &lhs);
 
-        static void CheckModulus(const NaturalType &lhs, const NaturalType &rhs);
+        static constexpr void CheckModulus(const NaturalType &lhs, const NaturalType &rhs);
 
-        static void CheckIncrement(const NaturalType &lhs);
+        static constexpr void CheckIncrement(const NaturalType &lhs);
 
-        static void CheckDecrement(const NaturalType &lhs);
+        static constexpr void CheckDecrement(const NaturalType &lhs);
 
-        static void CheckBitwiseLeftShift(const NaturalType &lhs, std::size_t rhs);
+        static constexpr void CheckBitwiseLeftShift(const NaturalType &lhs, std::size_t rhs);
     };
 
     template<class _NaturalType, template<class...> class _Checker = CheckNoOverflow, DECLARATION_DEFAULT_TEMPLATE_PARAMS >
@@ -287,6 +294,236 @@ namespace fractional::overflow {
         static constexpr void CheckBitwiseLeftShift(const NaturalType &lhs, std::size_t rhs) noexcept {};
     };
 
+    /**
+     * Class for checking overflowing with compiler intrinsics, _NaturalType must be built-in integer
+     * Contains static methods to check overflow, return true if it is not overflows, false otherwise
+     */
+    template<class _NaturalType, DECLARATION_DEFAULT_TEMPLATE_PARAMS >
+    struct BuiltinCheckOverflow {
+        static_assert(std::is_integral_v<_NaturalType>, "_NaturalType must be built-in integer");
+        using NaturalType = _NaturalType;
+
+        using PlusOperator = _PlusOperator;
+        using MinusOperator = _MinusOperator;
+        using MultiplyOperator = _MultiplyOperator;
+        using DivideOperator = _DivideOperator;
+        using NegateOperator = _NegateOperator;
+        using ModulusOperator = _ModulusOperator;
+
+        using EqualOperator = _EqualOperator;
+        using NoEqualOperator = _NoEqualOperator;
+        using GreaterOperator = _GreaterOperator;
+        using GreaterEqualOperator = _GreaterEqualOperator;
+        using LessOperator = _LessOperator;
+        using LessEqualOperator = _LessEqualOperator;
+
+        static constexpr bool CheckMultiply(const NaturalType &lhs, const NaturalType &rhs) noexcept;
+
+        static constexpr bool CheckPlus(const NaturalType &lhs, const NaturalType &rhs) noexcept;
+
+        static constexpr bool CheckMinus(const NaturalType &lhs, const NaturalType &rhs) noexcept;
+
+        static constexpr bool CheckDivide(const NaturalType &lhs, const NaturalType &rhs) noexcept;
+
+        static constexpr bool CheckNegate(const NaturalType &lhs) noexcept;
+
+        static constexpr bool CheckModulus(const NaturalType &lhs, const NaturalType &rhs) noexcept;
+
+        static constexpr bool CheckIncrement(const NaturalType &lhs) noexcept;
+
+        static constexpr bool CheckDecrement(const NaturalType &lhs) noexcept;
+
+        static constexpr bool CheckBitwiseLeftShift(const NaturalType &lhs, std::size_t rhs);
+    };
+
+    /**
+     * Throwing checker computing plus, minus and multiply with one __builtin_*_overflow call.
+     * CheckPlus, CheckMinus and CheckMultiply return the checked result, so
+     * utility::OperatorWrapper does not compute the operation a second time.
+     */
+    template<class _NaturalType, template<class...> class _Checker = BuiltinCheckOverflow, DECLARATION_DEFAULT_TEMPLATE_PARAMS >
+    struct BuiltinThrowOnCheck {
+        static_assert(std::is_integral_v<_NaturalType>, "_NaturalType must be built-in integer");
+        static_assert(std::is_same_v<_PlusOperator, std::plus<_NaturalType>> &&
+                      std::is_same_v<_MinusOperator, std::minus<_NaturalType>> &&
+                      std::is_same_v<_MultiplyOperator, std::multiplies<_NaturalType>>,
+                      "Intrinsics replace plus, minus and multiply operators, they must be the std ones");
+        using NaturalType = _NaturalType;
+
+        using Checker = _Checker<NaturalType, TEMPLATE_PARAMS>;
+        using BinaryError = OverflowBinaryError<NaturalType, NaturalType>;
+        using BitwiseError = OverflowBinaryError<NaturalType, std::size_t>;
+        using UnaryError = OverflowUnaryError<NaturalType>;
+
+        using PlusOperator = _PlusOperator;
+        using MinusOperator = _MinusOperator;
+        using MultiplyOperator = _MultiplyOperator;
+        using DivideOperator = _DivideOperator;
+        using NegateOperator = _NegateOperator;
+        using ModulusOperator = _ModulusOperator;
+
+        using EqualOperator = _EqualOperator;
+        using NoEqualOperator = _NoEqualOperator;
+        using GreaterOperator = _GreaterOperator;
+        using GreaterEqualOperator = _GreaterEqualOperator;
+        using LessOperator = _LessOperator;
+        using LessEqualOperator = _LessEqualOperator;
+
+        static constexpr NaturalType CheckMultiply(const NaturalType &lhs, const NaturalType &rhs);
+
+        static constexpr NaturalType CheckPlus(const NaturalType &lhs, const NaturalType &rhs);
+
+        static constexpr NaturalType CheckMinus(const NaturalType &lhs, const NaturalType &rhs);
+
+        static constexpr void CheckDivide(const NaturalType &lhs, const NaturalType &rhs);
+
+        static constexpr void CheckNegate(const NaturalType &lhs);
+
+        static constexpr void CheckModulus(const NaturalType &lhs, const NaturalType &rhs);
+
+        static constexpr void CheckIncrement(const NaturalType &lhs);
+
+        static constexpr void CheckDecrement(const NaturalType &lhs);
+
+        static constexpr void CheckBitwiseLeftShift(const NaturalType &lhs, std::size_t rhs);
+    };
+
+    /**
+     * Throwing checker that makes Fractional compute plus, minus, multiply and divide in
+     * WideType (twice the width of _NaturalType), reduce there and check the range once
+     * when narrowing back. Intermediate overflow no longer throws if the reduced result fits.
+     */
+    template<class _NaturalType, template<class...> class _Checker = IntegralCheckOverflow, DECLARATION_DEFAULT_TEMPLATE_PARAMS >
+    struct WideningThrowOnCheck : ThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS> {
+        static_assert(utility::HasWider<_NaturalType>::value, "_NaturalType has no wider built-in integer");
+        using NaturalType = _NaturalType;
+        using WideType = utility::WiderType<NaturalType>;
+
+        using WideError = OverflowBinaryError<WideType, WideType>;
+        using NarrowError = OverflowUnaryError<WideType>;
+
+        static constexpr WideType WidePlus(const WideType &lhs, const WideType &rhs);
+
+        static constexpr WideType WideMinus(const WideType &lhs, const WideType &rhs);
+
+        static constexpr NaturalType Narrow(const WideType &value);
+    };
+
+    /**
+     * Bits of OverflowStatus, one per checked operation
+     */
+    struct OverflowFlags {
+        using Type = unsigned;
+
+        static constexpr Type None = 0;
+        static constexpr Type Plus = 1u << 0u;
+        static constexpr Type Minus = 1u << 1u;
+        static constexpr Type Multiply = 1u << 2u;
+        static constexpr Type Divide = 1u << 3u;
+        static constexpr Type Negate = 1u << 4u;
+        static constexpr Type Modulus = 1u << 5u;
+        static constexpr Type Increment = 1u << 6u;
+        static constexpr Type Decrement = 1u << 7u;
+        static constexpr Type BitwiseLeftShift = 1u << 8u;
+        static constexpr Type All = (1u << 9u) - 1;
+    };
+
+    /**
+     * Per-thread sticky overflow flags raised by FlagOnCheck, like the floating-point
+     * exception flags of <cfenv>: nothing but Clear resets them.
+     */
+    struct OverflowStatus {
+        using Flags = OverflowFlags::Type;
+
+        /**
+         * @return raised flags among flags
+         */
+        static Flags Test(Flags flags = OverflowFlags::All) noexcept {
+            return flags_ & flags;
+        }
+
+        static void Clear(Flags flags = OverflowFlags::All) noexcept {
+            flags_ &= ~flags;
+        }
+
+        static void Raise(Flags flags) noexcept {
+            flags_ |= flags;
+        }
+
+        /**
+         * Replaces all flags, restores a state saved with Test()
+         */
+        static void Set(Flags flags) noexcept {
+            flags_ = flags;
+        }
+
+    private:
+        static inline thread_local Flags flags_ = OverflowFlags::None;
+    };
+
+    /**
+     * Non-throwing checker: every check is noexcept and raises its OverflowFlags bit in
+     * OverflowStatus instead of throwing, the operation still produces a value.
+     * For built-in integers with std operators CheckPlus, CheckMinus, CheckMultiply,
+     * CheckNegate, CheckDivide and CheckModulus return the result themselves: plus, minus,
+     * multiply and negate wrap around via __builtin_*_overflow, a zero or overflowing
+     * divisor is replaced with one, so no undefined behaviour is reached and no branch is taken.
+     */
+    template<class _NaturalType, template<class...> class _Checker = IntegralCheckOverflow, DECLARATION_DEFAULT_TEMPLATE_PARAMS >
+    struct FlagOnCheck {
+        using NaturalType = _NaturalType;
+
+        using Checker = _Checker<NaturalType, TEMPLATE_PARAMS>;
+        using BinaryError = OverflowBinaryError<NaturalType, NaturalType>;
+        using BitwiseError = OverflowBinaryError<NaturalType, std::size_t>;
+        using UnaryError = OverflowUnaryError<NaturalType>;
+
+        using PlusOperator = _PlusOperator;
+        using MinusOperator = _MinusOperator;
+        using MultiplyOperator = _MultiplyOperator;
+        using DivideOperator = _DivideOperator;
+        using NegateOperator = _NegateOperator;
+        using ModulusOperator = _ModulusOperator;
+
+        using EqualOperator = _EqualOperator;
+        using NoEqualOperator = _NoEqualOperator;
+        using GreaterOperator = _GreaterOperator;
+        using GreaterEqualOperator = _GreaterEqualOperator;
+        using LessOperator = _LessOperator;
+        using LessEqualOperator = _LessEqualOperator;
+
+        static constexpr bool IsBuiltin = std::is_integral_v<NaturalType> &&
+                                          std::is_same_v<_PlusOperator, std::plus<NaturalType>> &&
+                                          std::is_same_v<_MinusOperator, std::minus<NaturalType>> &&
+                                          std::is_same_v<_MultiplyOperator, std::multiplies<NaturalType>> &&
+                                          std::is_same_v<_DivideOperator, std::divides<NaturalType>> &&
+                                          std::is_same_v<_NegateOperator, std::negate<NaturalType>> &&
+                                          std::is_same_v<_ModulusOperator, std::modulus<NaturalType>>;
+
+        /**
+         * NaturalType if checks compute the result, void if the operator is applied after the check
+         */
+        using ResultType = std::conditional_t<IsBuiltin, NaturalType, void>;
+
+        static ResultType CheckMultiply(const NaturalType &lhs, const NaturalType &rhs) noexcept;
+
+        static ResultType CheckPlus(const NaturalType &lhs, const NaturalType &rhs) noexcept;
+
+        static ResultType CheckDivide(const NaturalType &lhs, const NaturalType &rhs) noexcept;
+
+        static ResultType CheckMinus(const NaturalType &lhs, const NaturalType &rhs) noexcept;
+
+        static ResultType CheckNegate(const NaturalType &lhs) noexcept;
+
+        static ResultType CheckModulus(const NaturalType &lhs, const NaturalType &rhs) noexcept;
+
+        static void CheckIncrement(const NaturalType &lhs) noexcept;
+
+        static void CheckDecrement(const NaturalType &lhs) noexcept;
+
+        static void CheckBitwiseLeftShift(const NaturalType &lhs, std::size_t rhs) noexcept;
+    };
+
     template<class _NaturalType>
     struct OverflowChecker : ThrowOnCheck<_NaturalType> {
     };
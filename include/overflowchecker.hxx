@@ -51,25 +51,26 @@ namespace fractional::overflow {
         if (IsNegativeOne<NaturalType, EqualOperator>(rhs) && EqualOperator{}(lhs, min_value))
             return CheckMinNegate();
 
-        bool is_positive_one = IsPositiveOne<NaturalType, EqualOperator>(lhs);
-
-        bool is_positive_overflow = EqualOperator{}(rhs, NaturalType{}) ||
-                                    LessEqualOperator{}(lhs, DivideOperator{}(max_value, rhs));
-
-        bool is_negative_overflow =
-                EqualOperator{}(rhs, NaturalType{}) || GreaterEqualOperator{}(lhs, DivideOperator{}(min_value, rhs));
+        auto zero = NaturalType{};
+        if (EqualOperator{}(lhs, zero) || EqualOperator{}(rhs, zero))
+            return true;
 
-        return is_positive_one ||
-               (is_positive_overflow && is_negative_overflow);
+        if (GreaterOperator{}(lhs, zero)) {
+            return GreaterOperator{}(rhs, zero) ? LessEqualOperator{}(lhs, DivideOperator{}(max_value, rhs))
+                                                : GreaterEqualOperator{}(rhs, DivideOperator{}(min_value, lhs));
+        }
+        return GreaterOperator{}(rhs, zero) ? GreaterEqualOperator{}(lhs, DivideOperator{}(min_value, rhs))
+                                            : GreaterEqualOperator{}(lhs, DivideOperator{}(max_value, rhs));
     }
 
     template<class _NaturalType, DECLARATION_TEMPLATE_PARAMS>
     constexpr bool IntegralCheckOverflow<_NaturalType, TEMPLATE_PARAMS>::CheckPlus(
             const NaturalType &lhs, const NaturalType &rhs) {
         auto max_value = numeric_limits<NaturalType>::max();
+        auto min_value = numeric_limits<NaturalType>::lowest();
         auto zero = NaturalType{};
         return !((GreaterOperator{}(rhs, zero) && GreaterOperator{}(lhs, MinusOperator{}(max_value, rhs))) ||
-                 (LessOperator{}(rhs, zero) && LessOperator{}(lhs, PlusOperator{}(max_value, rhs))));
+                 (LessOperator{}(rhs, zero) && LessOperator{}(lhs, MinusOperator{}(min_value, rhs))));
     }
 
     template<class _NaturalType, DECLARATION_TEMPLATE_PARAMS>
@@ -77,9 +78,10 @@ namespace fractional::overflow {
     IntegralCheckOverflow<_NaturalType, TEMPLATE_PARAMS>::CheckMinus(
             const NaturalType &lhs, const NaturalType &rhs) {
         auto max_value = numeric_limits<NaturalType>::max();
+        auto min_value = numeric_limits<NaturalType>::lowest();
         auto zero = NaturalType{};
         bool first_test = LessOperator{}(rhs, zero) && GreaterOperator{}(lhs, PlusOperator{}(max_value, rhs));
-        bool second_test = GreaterOperator{}(rhs, zero) && LessOperator{}(lhs, MinusOperator{}(max_value, rhs));
+        bool second_test = GreaterOperator{}(rhs, zero) && LessOperator{}(lhs, PlusOperator{}(min_value, rhs));
         return !(first_test || second_test);
     }
 
@@ -115,7 +117,7 @@ namespace fractional::overflow {
     constexpr bool IntegralCheckOverflow<_NaturalType, TEMPLATE_PARAMS>::CheckDivide(
             const NaturalType &lhs, const NaturalType &rhs) {
         return NoEqualOperator{}(rhs, NaturalType{}) &&
-               (IsNegativeOne<NaturalType, EqualOperator>(rhs) && CheckNegate(lhs));
+               (!IsNegativeOne<NaturalType, EqualOperator>(rhs) || CheckNegate(lhs));
     }
 
     template<class _NaturalType, DECLARATION_TEMPLATE_PARAMS>
@@ -149,14 +151,16 @@ namespace fractional::overflow {
             const NaturalType &lhs, const NaturalType &rhs) {
         if (EqualOperator{}(rhs, NaturalType{}))
             return false;
-        if (std::is_unsigned_v<NaturalType>)
+        if constexpr (std::is_unsigned_v<NaturalType>) {
             return true;
-        auto min = std::numeric_limits<NaturalType>::lowest();
-        return NoEqualOperator{}(lhs, min) || NoEqualOperator{}(rhs, NegativeOne<NaturalType>());
+        } else {
+            auto min = std::numeric_limits<NaturalType>::lowest();
+            return NoEqualOperator{}(lhs, min) || NoEqualOperator{}(rhs, NegativeOne<NaturalType>());
+        }
     }
 
     template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
-    void
+    constexpr void
     ThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckMultiply(
             const NaturalType &lhs, const NaturalType &rhs) {
         if (!Checker::CheckMultiply(lhs, rhs)) {
@@ -165,16 +169,16 @@ namespace fractional::overflow {
     }
 
     template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
-    void
+    constexpr void
     ThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckPlus(
             const NaturalType &lhs, const NaturalType &rhs) {
-        if (!Checker::CheckMultiply(lhs, rhs)) {
+        if (!Checker::CheckPlus(lhs, rhs)) {
             throw BinaryError(lhs, rhs);
         }
     }
 
     template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
-    void
+    constexpr void
     ThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckDivide(
             const NaturalType &lhs, const NaturalType &rhs) {
         if (!Checker::CheckDivide(lhs, rhs)) {
@@ -183,7 +187,7 @@ namespace fractional::overflow {
     }
 
     template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
-    void
+    constexpr void
     ThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckMinus(
             const NaturalType &lhs, const NaturalType &rhs) {
         if (!Checker::CheckMinus(lhs, rhs)) {
@@ -192,7 +196,7 @@ namespace fractional::overflow {
     }
 
     template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
-    void
+    constexpr void
     ThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckNegate(
             const NaturalType &lhs) {
         if (!Checker::CheckNegate(lhs)) {
@@ -201,7 +205,7 @@ namespace fractional::overflow {
     }
 
     template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
-    void
+    constexpr void
     ThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckModulus(
             const NaturalType &lhs, const NaturalType &rhs) {
         if (!Checker::CheckModulus(lhs, rhs)) {
@@ -210,7 +214,7 @@ namespace fractional::overflow {
     }
 
     template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
-    void
+    constexpr void
     ThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckIncrement(
             const NaturalType &lhs) {
         if (!Checker::CheckIncrement(lhs)) {
@@ -219,7 +223,7 @@ namespace fractional::overflow {
     }
 
     template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
-    void
+    constexpr void
     ThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckDecrement(
             const NaturalType &lhs) {
         if (!Checker::CheckDecrement(lhs)) {
@@ -228,13 +232,293 @@ namespace fractional::overflow {
     }
 
     template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
-    void
+    constexpr void
     ThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckBitwiseLeftShift(
             const NaturalType &lhs, std::size_t rhs) {
         if (!Checker::CheckBitwiseLeftShift(lhs, rhs)) {
             throw BitwiseError(lhs, rhs);
         }
     }
+
+    template<class _NaturalType, DECLARATION_TEMPLATE_PARAMS>
+    constexpr bool BuiltinCheckOverflow<_NaturalType, TEMPLATE_PARAMS>::CheckMultiply(
+            const NaturalType &lhs, const NaturalType &rhs) noexcept {
+        NaturalType result{};
+        return !__builtin_mul_overflow(lhs, rhs, &result);
+    }
+
+    template<class _NaturalType, DECLARATION_TEMPLATE_PARAMS>
+    constexpr bool BuiltinCheckOverflow<_NaturalType, TEMPLATE_PARAMS>::CheckPlus(
+            const NaturalType &lhs, const NaturalType &rhs) noexcept {
+        NaturalType result{};
+        return !__builtin_add_overflow(lhs, rhs, &result);
+    }
+
+    template<class _NaturalType, DECLARATION_TEMPLATE_PARAMS>
+    constexpr bool BuiltinCheckOverflow<_NaturalType, TEMPLATE_PARAMS>::CheckMinus(
+            const NaturalType &lhs, const NaturalType &rhs) noexcept {
+        NaturalType result{};
+        return !__builtin_sub_overflow(lhs, rhs, &result);
+    }
+
+    template<class _NaturalType, DECLARATION_TEMPLATE_PARAMS>
+    constexpr bool BuiltinCheckOverflow<_NaturalType, TEMPLATE_PARAMS>::CheckDivide(
+            const NaturalType &lhs, const NaturalType &rhs) noexcept {
+        if (rhs == 0)
+            return false;
+        if constexpr (std::is_signed_v<NaturalType>) {
+            return rhs != -1 || lhs != numeric_limits<NaturalType>::lowest();
+        }
+        return true;
+    }
+
+    template<class _NaturalType, DECLARATION_TEMPLATE_PARAMS>
+    constexpr bool BuiltinCheckOverflow<_NaturalType, TEMPLATE_PARAMS>::CheckNegate(
+            const NaturalType &lhs) noexcept {
+        NaturalType result{};
+        return !__builtin_sub_overflow(NaturalType{}, lhs, &result);
+    }
+
+    template<class _NaturalType, DECLARATION_TEMPLATE_PARAMS>
+    constexpr bool BuiltinCheckOverflow<_NaturalType, TEMPLATE_PARAMS>::CheckModulus(
+            const NaturalType &lhs, const NaturalType &rhs) noexcept {
+        return CheckDivide(lhs, rhs);
+    }
+
+    template<class _NaturalType, DECLARATION_TEMPLATE_PARAMS>
+    constexpr bool BuiltinCheckOverflow<_NaturalType, TEMPLATE_PARAMS>::CheckIncrement(
+            const NaturalType &lhs) noexcept {
+        return CheckPlus(lhs, NaturalType{1});
+    }
+
+    template<class _NaturalType, DECLARATION_TEMPLATE_PARAMS>
+    constexpr bool BuiltinCheckOverflow<_NaturalType, TEMPLATE_PARAMS>::CheckDecrement(
+            const NaturalType &lhs) noexcept {
+        return CheckMinus(lhs, NaturalType{1});
+    }
+
+    template<class _NaturalType, DECLARATION_TEMPLATE_PARAMS>
+    constexpr bool BuiltinCheckOverflow<_NaturalType, TEMPLATE_PARAMS>::CheckBitwiseLeftShift(
+            const NaturalType &lhs, std::size_t rhs) {
+        return IntegralCheckOverflow<NaturalType, TEMPLATE_PARAMS>::CheckBitwiseLeftShift(lhs, rhs);
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    constexpr _NaturalType
+    BuiltinThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckMultiply(
+            const NaturalType &lhs, const NaturalType &rhs) {
+        NaturalType result{};
+        if (__builtin_mul_overflow(lhs, rhs, &result)) {
+            throw BinaryError(lhs, rhs);
+        }
+        return result;
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    constexpr _NaturalType
+    BuiltinThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckPlus(
+            const NaturalType &lhs, const NaturalType &rhs) {
+        NaturalType result{};
+        if (__builtin_add_overflow(lhs, rhs, &result)) {
+            throw BinaryError(lhs, rhs);
+        }
+        return result;
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    constexpr _NaturalType
+    BuiltinThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckMinus(
+            const NaturalType &lhs, const NaturalType &rhs) {
+        NaturalType result{};
+        if (__builtin_sub_overflow(lhs, rhs, &result)) {
+            throw BinaryError(lhs, rhs);
+        }
+        return result;
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    constexpr void
+    BuiltinThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckDivide(
+            const NaturalType &lhs, const NaturalType &rhs) {
+        if (!Checker::CheckDivide(lhs, rhs)) {
+            throw BinaryError(lhs, rhs);
+        }
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    constexpr void
+    BuiltinThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckNegate(
+            const NaturalType &lhs) {
+        if (!Checker::CheckNegate(lhs)) {
+            throw UnaryError(lhs);
+        }
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    constexpr void
+    BuiltinThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckModulus(
+            const NaturalType &lhs, const NaturalType &rhs) {
+        if (!Checker::CheckModulus(lhs, rhs)) {
+            throw BinaryError(lhs, rhs);
+        }
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    constexpr void
+    BuiltinThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckIncrement(
+            const NaturalType &lhs) {
+        if (!Checker::CheckIncrement(lhs)) {
+            throw UnaryError(lhs);
+        }
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    constexpr void
+    BuiltinThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckDecrement(
+            const NaturalType &lhs) {
+        if (!Checker::CheckDecrement(lhs)) {
+            throw UnaryError(lhs);
+        }
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    constexpr void
+    BuiltinThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckBitwiseLeftShift(
+            const NaturalType &lhs, std::size_t rhs) {
+        if (!Checker::CheckBitwiseLeftShift(lhs, rhs)) {
+            throw BitwiseError(lhs, rhs);
+        }
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    constexpr typename WideningThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::WideType
+    WideningThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::WidePlus(
+            const WideType &lhs, const WideType &rhs) {
+        WideType result{};
+        if (__builtin_add_overflow(lhs, rhs, &result)) {
+            throw WideError(lhs, rhs);
+        }
+        return result;
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    constexpr typename WideningThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::WideType
+    WideningThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::WideMinus(
+            const WideType &lhs, const WideType &rhs) {
+        WideType result{};
+        if (__builtin_sub_overflow(lhs, rhs, &result)) {
+            throw WideError(lhs, rhs);
+        }
+        return result;
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    constexpr _NaturalType
+    WideningThrowOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::Narrow(const WideType &value) {
+        if (value < WideType(numeric_limits<NaturalType>::lowest()) ||
+            value > WideType(numeric_limits<NaturalType>::max())) {
+            throw NarrowError(value);
+        }
+        return NaturalType(value);
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    typename FlagOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::ResultType
+    FlagOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckMultiply(
+            const NaturalType &lhs, const NaturalType &rhs) noexcept {
+        if constexpr (IsBuiltin) {
+            NaturalType result;
+            OverflowStatus::Raise(OverflowFlags::Multiply * unsigned(__builtin_mul_overflow(lhs, rhs, &result)));
+            return result;
+        } else {
+            OverflowStatus::Raise(OverflowFlags::Multiply * unsigned(!Checker::CheckMultiply(lhs, rhs)));
+        }
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    typename FlagOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::ResultType
+    FlagOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckPlus(
+            const NaturalType &lhs, const NaturalType &rhs) noexcept {
+        if constexpr (IsBuiltin) {
+            NaturalType result;
+            OverflowStatus::Raise(OverflowFlags::Plus * unsigned(__builtin_add_overflow(lhs, rhs, &result)));
+            return result;
+        } else {
+            OverflowStatus::Raise(OverflowFlags::Plus * unsigned(!Checker::CheckPlus(lhs, rhs)));
+        }
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    typename FlagOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::ResultType
+    FlagOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckDivide(
+            const NaturalType &lhs, const NaturalType &rhs) noexcept {
+        bool overflow = !Checker::CheckDivide(lhs, rhs);
+        OverflowStatus::Raise(OverflowFlags::Divide * unsigned(overflow));
+        if constexpr (IsBuiltin) {
+            auto divisor = overflow ? NaturalType(1) : rhs;
+            return NaturalType(lhs / divisor);
+        }
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    typename FlagOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::ResultType
+    FlagOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckMinus(
+            const NaturalType &lhs, const NaturalType &rhs) noexcept {
+        if constexpr (IsBuiltin) {
+            NaturalType result;
+            OverflowStatus::Raise(OverflowFlags::Minus * unsigned(__builtin_sub_overflow(lhs, rhs, &result)));
+            return result;
+        } else {
+            OverflowStatus::Raise(OverflowFlags::Minus * unsigned(!Checker::CheckMinus(lhs, rhs)));
+        }
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    typename FlagOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::ResultType
+    FlagOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckNegate(
+            const NaturalType &lhs) noexcept {
+        if constexpr (IsBuiltin) {
+            NaturalType result;
+            bool overflow = __builtin_sub_overflow(NaturalType{}, lhs, &result);
+            OverflowStatus::Raise(OverflowFlags::Negate * unsigned(overflow));
+            return result;
+        } else {
+            OverflowStatus::Raise(OverflowFlags::Negate * unsigned(!Checker::CheckNegate(lhs)));
+        }
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    typename FlagOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::ResultType
+    FlagOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckModulus(
+            const NaturalType &lhs, const NaturalType &rhs) noexcept {
+        bool overflow = !Checker::CheckModulus(lhs, rhs);
+        OverflowStatus::Raise(OverflowFlags::Modulus * unsigned(overflow));
+        if constexpr (IsBuiltin) {
+            auto divisor = overflow ? NaturalType(1) : rhs;
+            return NaturalType(lhs % divisor);
+        }
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    void
+    FlagOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckIncrement(
+            const NaturalType &lhs) noexcept {
+        OverflowStatus::Raise(OverflowFlags::Increment * unsigned(!Checker::CheckIncrement(lhs)));
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    void
+    FlagOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckDecrement(
+            const NaturalType &lhs) noexcept {
+        OverflowStatus::Raise(OverflowFlags::Decrement * unsigned(!Checker::CheckDecrement(lhs)));
+    }
+
+    template<class _NaturalType, template<class...> class _Checker, DECLARATION_TEMPLATE_PARAMS>
+    void
+    FlagOnCheck<_NaturalType, _Checker, TEMPLATE_PARAMS>::CheckBitwiseLeftShift(
+            const NaturalType &lhs, std::size_t rhs) noexcept {
+        OverflowStatus::Raise(OverflowFlags::BitwiseLeftShift * unsigned(!Checker::CheckBitwiseLeftShift(lhs, rhs)));
+    }
 }
 
 #endif //FRACTIONNUMBER_OVERFLOWCHECKER_HXX
@@ -0,0 +1,113 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_PARALLEL_HPP
+#define FRACTIONNUMBER_PARALLEL_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "fractional.hpp"
+
+#ifdef FRACTIONAL_EXECUTION_POLICY
+#include <execution>
+#endif
+
+/**
+ * Exact reductions of large ranges. Elements are cut into chunks of ReduceOptions::grain,
+ * worker threads pull chunks, each chunk and then the chunk partials are combined in
+ * balanced trees, so operands of every step have about the same size. Partials are
+ * brought to canonical form before merging. For an associative op the result is the
+ * value of the serial left fold, bounded NaturalType may overflow on a different step.
+ *
+ * Overloads taking a std::execution policy are declared when FRACTIONAL_EXECUTION_POLICY
+ * is defined: <execution> of libstdc++ requires linking TBB.
+ */
+NAMESPACE_FRACTIONAL_BEGIN
+    struct ReduceOptions {
+        /**
+         * Worker threads including the caller, 0 for std::thread::hardware_concurrency
+         */
+        std::size_t threads = 0;
+
+        /**
+         * Elements per chunk, a chunk is the unit of work of a thread
+         */
+        std::size_t grain = 4096;
+    };
+
+    /**
+     * op(...op(op(init, *first), *(first + 1))..., *(last - 1)) with op associative
+     */
+    template<class _ForwardIt, class T, class _BinaryOp>
+    T reduce(_ForwardIt first, _ForwardIt last, T init, _BinaryOp op, ReduceOptions options = {});
+
+    /**
+     * Sum of [first, last), zero for an empty range
+     */
+    template<class _ForwardIt>
+    typename std::iterator_traits<_ForwardIt>::value_type
+    sum(_ForwardIt first, _ForwardIt last, ReduceOptions options = {});
+
+    /**
+     * Product of [first, last), one for an empty range
+     */
+    template<class _ForwardIt>
+    typename std::iterator_traits<_ForwardIt>::value_type
+    product(_ForwardIt first, _ForwardIt last, ReduceOptions options = {});
+
+    /**
+     * Sum of first1[i] * first2[i] over [first1, last1)
+     */
+    template<class _ForwardIt1, class _ForwardIt2>
+    typename std::iterator_traits<_ForwardIt1>::value_type
+    dot(_ForwardIt1 first1, _ForwardIt1 last1, _ForwardIt2 first2, ReduceOptions options = {});
+
+#ifdef FRACTIONAL_EXECUTION_POLICY
+    template<class _ExecutionPolicy>
+    using EnableIfExecutionPolicy = std::enable_if_t<std::is_execution_policy_v<std::decay_t<_ExecutionPolicy>>>;
+
+    /**
+     * std::execution::seq runs on the calling thread, other policies on every hardware thread
+     */
+    template<class _ExecutionPolicy>
+    ReduceOptions OptionsFor(_ExecutionPolicy &&) noexcept {
+        ReduceOptions options;
+        if constexpr (std::is_same_v<std::decay_t<_ExecutionPolicy>, std::execution::sequenced_policy>) {
+            options.threads = 1;
+        }
+        return options;
+    }
+
+    template<class _ExecutionPolicy, class _ForwardIt, class T, class _BinaryOp,
+            typename = EnableIfExecutionPolicy<_ExecutionPolicy>>
+    T reduce(_ExecutionPolicy &&policy, _ForwardIt first, _ForwardIt last, T init, _BinaryOp op) {
+        return reduce(first, last, std::move(init), op, OptionsFor(policy));
+    }
+
+    template<class _ExecutionPolicy, class _ForwardIt, typename = EnableIfExecutionPolicy<_ExecutionPolicy>>
+    typename std::iterator_traits<_ForwardIt>::value_type
+    sum(_ExecutionPolicy &&policy, _ForwardIt first, _ForwardIt last) {
+        return sum(first, last, OptionsFor(policy));
+    }
+
+    template<class _ExecutionPolicy, class _ForwardIt, typename = EnableIfExecutionPolicy<_ExecutionPolicy>>
+    typename std::iterator_traits<_ForwardIt>::value_type
+    product(_ExecutionPolicy &&policy, _ForwardIt first, _ForwardIt last) {
+        return product(first, last, OptionsFor(policy));
+    }
+
+    template<class _ExecutionPolicy, class _ForwardIt1, class _ForwardIt2,
+            typename = EnableIfExecutionPolicy<_ExecutionPolicy>>
+    typename std::iterator_traits<_ForwardIt1>::value_type
+    dot(_ExecutionPolicy &&policy, _ForwardIt1 first1, _ForwardIt1 last1, _ForwardIt2 first2) {
+        return dot(first1, last1, first2, OptionsFor(policy));
+    }
+#endif
+NAMESPACE_FRACTIONAL_END
+
+#include "parallel.hxx"
+
+#endif //FRACTIONNUMBER_PARALLEL_HPP
@@ -0,0 +1,225 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_PARALLEL_HXX
+#define FRACTIONNUMBER_PARALLEL_HXX
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "parallel.hpp"
+
+NAMESPACE_FRACTIONAL_BEGIN
+    namespace {
+        template<class T, typename = void>
+        struct HasReduce : std::false_type {
+        };
+
+        template<class T>
+        struct HasReduce<T, std::void_t<decltype(std::declval<T &>().reduce())>> : std::true_type {
+        };
+
+        template<class T, typename = void>
+        struct AlwaysCanonical : std::false_type {
+        };
+
+        template<class T>
+        struct AlwaysCanonical<T, std::void_t<typename T::Normalization>>
+                : std::bool_constant<T::Normalization::IsCanonical> {
+        };
+
+        /**
+         * Brings a partial to canonical form before it is merged,
+         * no-op for types without reduce() and for already canonical values
+         */
+        template<class T>
+        void Canonicalize(T &value) {
+            if constexpr (HasReduce<T>::value && !AlwaysCanonical<T>::value) {
+                value.reduce();
+            }
+        }
+
+        /**
+         * Pairwise combination keeping O(log n) partials: a partial of 2^k operands is
+         * merged only with another one of 2^k operands. Operand order is preserved,
+         * partials are stored in canonical form.
+         */
+        template<class T, class _BinaryOp>
+        class PairwiseReducer {
+        public:
+            explicit PairwiseReducer(_BinaryOp op) : op_(op) {}
+
+            void push(T value) {
+                std::size_t level = 0;
+                while (!partials_.empty() && partials_.back().second == level) {
+                    value = op_(std::move(partials_.back().first), std::move(value));
+                    partials_.pop_back();
+                    ++level;
+                }
+                Canonicalize(value);
+                partials_.emplace_back(std::move(value), level);
+            }
+
+            std::optional<T> result() {
+                if (partials_.empty())
+                    return std::nullopt;
+                auto value = std::move(partials_.back().first);
+                partials_.pop_back();
+                while (!partials_.empty()) {
+                    Canonicalize(value);
+                    value = op_(std::move(partials_.back().first), std::move(value));
+                    partials_.pop_back();
+                }
+                Canonicalize(value);
+                return value;
+            }
+
+        private:
+            _BinaryOp op_;
+            std::vector<std::pair<T, std::size_t>> partials_;
+        };
+
+        /**
+         * Runs body(chunk) for chunk in [0, chunks) on up to threads threads, the caller included.
+         * The first exception thrown by a body is rethrown after every thread has joined.
+         */
+        template<class _Body>
+        void ParallelFor(std::size_t chunks, std::size_t threads, _Body body) {
+            if (threads == 0)
+                threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+            threads = std::min(threads, chunks);
+
+            std::atomic<std::size_t> next{0};
+            std::atomic<bool> failed{false};
+            std::exception_ptr error;
+            auto worker = [&] {
+                for (auto chunk = next++; chunk < chunks && !failed; chunk = next++) {
+                    try {
+                        body(chunk);
+                    } catch (...) {
+                        if (!failed.exchange(true))
+                            error = std::current_exception();
+                    }
+                }
+            };
+
+            std::vector<std::thread> pool;
+            pool.reserve(threads > 0 ? threads - 1 : 0);
+            for (std::size_t i = 1; i < threads; ++i) {
+                pool.emplace_back(worker);
+            }
+            worker();
+            for (auto &thread : pool) {
+                thread.join();
+            }
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+        /**
+         * Iterators to the start of every grain-sized chunk of [first, first + size)
+         */
+        template<class _ForwardIt>
+        std::vector<_ForwardIt> ChunkStarts(_ForwardIt first, std::size_t size, std::size_t grain) {
+            std::vector<_ForwardIt> starts;
+            starts.reserve((size + grain - 1) / grain);
+            for (std::size_t i = 0; i < size; i += grain) {
+                starts.push_back(first);
+                if (i + grain < size)
+                    std::advance(first, grain);
+            }
+            return starts;
+        }
+
+        /**
+         * Calls body(chunk, count, reducer) for every chunk in parallel, body pushes the count
+         * operands of the chunk into reducer. Chunk partials are combined in chunk order.
+         * @return nullopt for an empty range
+         */
+        template<class T, class _BinaryOp, class _ChunkBody>
+        std::optional<T> ChunkedReduce(std::size_t size, std::size_t grain, _BinaryOp op, _ChunkBody body,
+                                       const ReduceOptions &options) {
+            auto chunks = (size + grain - 1) / grain;
+            std::vector<std::optional<T>> partials(chunks);
+            ParallelFor(chunks, options.threads, [&](std::size_t chunk) {
+                PairwiseReducer<T, _BinaryOp> reducer{op};
+                body(chunk, std::min(grain, size - chunk * grain), reducer);
+                partials[chunk] = reducer.result();
+            });
+
+            PairwiseReducer<T, _BinaryOp> reducer{op};
+            for (auto &partial : partials) {
+                reducer.push(std::move(*partial));
+            }
+            return reducer.result();
+        }
+
+        template<class T, class _ForwardIt, class _BinaryOp>
+        std::optional<T> RangeReduce(_ForwardIt first, _ForwardIt last, _BinaryOp op, const ReduceOptions &options) {
+            auto size = std::size_t(std::distance(first, last));
+            auto grain = std::max<std::size_t>(1, options.grain);
+            auto starts = ChunkStarts(first, size, grain);
+            return ChunkedReduce<T>(size, grain, op, [&](std::size_t chunk, std::size_t count, auto &reducer) {
+                auto it = starts[chunk];
+                for (std::size_t i = 0; i < count; ++i, ++it) {
+                    reducer.push(T(*it));
+                }
+            }, options);
+        }
+    }
+
+    template<class _ForwardIt, class T, class _BinaryOp>
+    T reduce(_ForwardIt first, _ForwardIt last, T init, _BinaryOp op, ReduceOptions options) {
+        auto result = RangeReduce<T>(first, last, op, options);
+        if (!result)
+            return init;
+        return op(std::move(init), std::move(*result));
+    }
+
+    template<class _ForwardIt>
+    typename std::iterator_traits<_ForwardIt>::value_type
+    sum(_ForwardIt first, _ForwardIt last, ReduceOptions options) {
+        using T = typename std::iterator_traits<_ForwardIt>::value_type;
+        using NaturalType = typename T::NaturalType;
+
+        auto result = RangeReduce<T>(first, last, std::plus<T>{}, options);
+        return result ? std::move(*result) : T{NaturalType{}, utility::One<NaturalType>()};
+    }
+
+    template<class _ForwardIt>
+    typename std::iterator_traits<_ForwardIt>::value_type
+    product(_ForwardIt first, _ForwardIt last, ReduceOptions options) {
+        using T = typename std::iterator_traits<_ForwardIt>::value_type;
+        using NaturalType = typename T::NaturalType;
+
+        auto result = RangeReduce<T>(first, last, std::multiplies<T>{}, options);
+        return result ? std::move(*result) : T{utility::One<NaturalType>(), utility::One<NaturalType>()};
+    }
+
+    template<class _ForwardIt1, class _ForwardIt2>
+    typename std::iterator_traits<_ForwardIt1>::value_type
+    dot(_ForwardIt1 first1, _ForwardIt1 last1, _ForwardIt2 first2, ReduceOptions options) {
+        using T = typename std::iterator_traits<_ForwardIt1>::value_type;
+        using NaturalType = typename T::NaturalType;
+
+        auto size = std::size_t(std::distance(first1, last1));
+        auto grain = std::max<std::size_t>(1, options.grain);
+        auto starts1 = ChunkStarts(first1, size, grain);
+        auto starts2 = ChunkStarts(first2, size, grain);
+        auto result = ChunkedReduce<T>(size, grain, std::plus<T>{},
+                                       [&](std::size_t chunk, std::size_t count, auto &reducer) {
+            auto lhs = starts1[chunk];
+            auto rhs = starts2[chunk];
+            for (std::size_t i = 0; i < count; ++i, ++lhs, ++rhs) {
+                reducer.push(T(*lhs * *rhs));
+            }
+        }, options);
+        return result ? std::move(*result) : T{NaturalType{}, utility::One<NaturalType>()};
+    }
+NAMESPACE_FRACTIONAL_END
+
+#endif //FRACTIONNUMBER_PARALLEL_HXX
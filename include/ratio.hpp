@@ -0,0 +1,96 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_RATIO_HPP
+#define FRACTIONNUMBER_RATIO_HPP
+
+#include <functional>
+#include <ratio>
+#include <type_traits>
+#include "fractional.hpp"
+
+/**
+ * Compile-time rationals in the spirit of std::ratio. C++17 does not allow class type
+ * template parameters, so a constant is the type BasicRatio<nominator, denominator>
+ * instead of a Fractional value. Ratio reduces its arguments with constexpr Fractional
+ * arithmetic, so equal values are the same type and specializations on Ratio<1, 2> also
+ * match Ratio<2, 4>. Arithmetic is checked by ThrowOnCheck, overflow fails compilation.
+ */
+NAMESPACE_FRACTIONAL_BEGIN
+    /**
+     * Canonical constant _Nominator/_Denominator, spelled through Ratio
+     */
+    template<auto _Nominator, decltype(_Nominator) _Denominator>
+    struct BasicRatio {
+        static_assert(std::is_integral_v<decltype(_Nominator)>, "BasicRatio requires built-in NaturalType");
+
+        using NaturalType = decltype(_Nominator);
+
+        static constexpr NaturalType nominator = _Nominator;
+        static constexpr NaturalType denominator = _Denominator;
+
+        /**
+         * The constant as a Fractional of any policy with the same NaturalType
+         */
+        template<class _Fract = Fractional<NaturalType>>
+        static constexpr _Fract value() {
+            return _Fract{nominator, denominator};
+        }
+
+        template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+        constexpr operator Fractional<FRACTIONAL_TEMPLATE_PARAMS>() const {
+            return value<Fractional<FRACTIONAL_TEMPLATE_PARAMS>>();
+        }
+    };
+
+    namespace {
+        template<class _NaturalType, _NaturalType _Nominator, _NaturalType _Denominator>
+        struct Canonical {
+            static constexpr Fractional<_NaturalType> value{_Nominator, _Denominator};
+
+            using type = BasicRatio<value.nominator(), value.denominator()>;
+        };
+
+        template<class _Lhs, class _Rhs, class _Operation>
+        struct RatioResult {
+            static_assert(std::is_same_v<typename _Lhs::NaturalType, typename _Rhs::NaturalType>,
+                          "Ratio arithmetic requires the same NaturalType");
+            using Fract = Fractional<typename _Lhs::NaturalType>;
+
+            static constexpr Fract value = _Operation{}(_Lhs::template value<Fract>(), _Rhs::template value<Fract>());
+
+            using type = BasicRatio<value.nominator(), value.denominator()>;
+        };
+    }
+
+    /**
+     * _Nominator/_Denominator reduced, with positive denominator
+     */
+    template<auto _Nominator, decltype(_Nominator) _Denominator = 1>
+    using Ratio = typename Canonical<decltype(_Nominator), _Nominator, _Denominator>::type;
+
+    /**
+     * Ratio with the value of std::ratio _StdRatio, NaturalType is std::intmax_t
+     */
+    template<class _StdRatio>
+    using RatioFromStd = Ratio<_StdRatio::num, _StdRatio::den>;
+
+    template<class _Lhs, class _Rhs>
+    using RatioAdd = typename RatioResult<_Lhs, _Rhs, std::plus<>>::type;
+
+    template<class _Lhs, class _Rhs>
+    using RatioSubtract = typename RatioResult<_Lhs, _Rhs, std::minus<>>::type;
+
+    template<class _Lhs, class _Rhs>
+    using RatioMultiply = typename RatioResult<_Lhs, _Rhs, std::multiplies<>>::type;
+
+    template<class _Lhs, class _Rhs>
+    using RatioDivide = typename RatioResult<_Lhs, _Rhs, std::divides<>>::type;
+
+    template<class _Lhs, class _Rhs>
+    struct RatioLess : std::bool_constant<(_Lhs::value() < _Rhs::value())> {
+    };
+NAMESPACE_FRACTIONAL_END
+
+#endif //FRACTIONNUMBER_RATIO_HPP
@@ -0,0 +1,98 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_ROUNDING_HPP
+#define FRACTIONNUMBER_ROUNDING_HPP
+
+#include "fractional.hpp"
+
+/**
+ * Exact integer parts and interval queries. Everything is computed from nominator and denominator
+ * with DivideOperator and ModulusOperator under the Checker of the type, there is no floating-point
+ * round-trip, so 64-bit and unbounded values round exactly. Values need not be canonical:
+ * denominators of either sign are handled.
+ */
+NAMESPACE_FRACTIONAL_BEGIN
+    /**
+     * value = quotient + remainder with 0 <= remainder < 1
+     */
+    template<class _Fract>
+    struct DivMod {
+        typename _Fract::NaturalType quotient;
+        _Fract remainder;
+    };
+
+    /**
+     * Greatest integer <= value
+     */
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr _NType floor(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &value);
+
+    /**
+     * Least integer >= value
+     */
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr _NType ceil(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &value);
+
+    /**
+     * Integer part, rounded toward zero
+     */
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr _NType trunc(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &value);
+
+    /**
+     * Nearest integer, ties to even
+     */
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr _NType round(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &value);
+
+    /**
+     * floor(value) and the proper fraction value - floor(value)
+     */
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr DivMod<Fractional<FRACTIONAL_TEMPLATE_PARAMS>>
+    divmod(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &value);
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS> abs(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &value);
+
+    /**
+     * (a + c)/(b + d) of the canonical forms a/b and c/d, strictly between them when they differ
+     */
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    mediant(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs, const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs);
+
+    /**
+     * Simplest rational of the closed interval between lhs and rhs, in either order: the one with
+     * the least denominator, and of those the least magnitude. Walks the Stern-Brocot tree along the
+     * common continued fraction prefix of the bounds, its terms never exceed the bounds.
+     */
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    between(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs, const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs);
+
+    /**
+     * out[i] = floor(first[i]) for every i in [0, last - first)
+     */
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    void floor(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> *first, const Fractional<FRACTIONAL_TEMPLATE_PARAMS> *last,
+               _NType *out);
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    void ceil(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> *first, const Fractional<FRACTIONAL_TEMPLATE_PARAMS> *last,
+              _NType *out);
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    void trunc(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> *first, const Fractional<FRACTIONAL_TEMPLATE_PARAMS> *last,
+               _NType *out);
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    void round(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> *first, const Fractional<FRACTIONAL_TEMPLATE_PARAMS> *last,
+               _NType *out);
+NAMESPACE_FRACTIONAL_END
+
+#include "rounding.hxx"
+
+#endif //FRACTIONNUMBER_ROUNDING_HPP
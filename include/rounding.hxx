@@ -0,0 +1,241 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_ROUNDING_HXX
+#define FRACTIONNUMBER_ROUNDING_HXX
+
+#include <utility>
+#include "rounding.hpp"
+
+NAMESPACE_FRACTIONAL_BEGIN
+    namespace {
+        /**
+         * floor(n/d) and the remainder n - floor(n/d) * d, which is zero or of the sign of d
+         */
+        template<class _Fract>
+        constexpr std::pair<typename _Fract::NaturalType, typename _Fract::NaturalType>
+        FloorDivide(const typename _Fract::NaturalType &nominator, const typename _Fract::NaturalType &denominator) {
+            using NaturalType = typename _Fract::NaturalType;
+            using Divide = typename _Fract::DivideOperator;
+            using Modulus = typename _Fract::ModulusOperator;
+            using Plus = typename _Fract::PlusOperator;
+            using Minus = typename _Fract::MinusOperator;
+
+            auto quotient = Divide{}(nominator, denominator);
+            auto remainder = Modulus{}(nominator, denominator);
+            if (Sign<_Fract>(remainder) * Sign<_Fract>(denominator) < 0) {
+                quotient = Minus{}(quotient, utility::One<NaturalType>());
+                remainder = Plus{}(remainder, denominator);
+            }
+            return {std::move(quotient), std::move(remainder)};
+        }
+
+        /**
+         * Copies of nominator and denominator in canonical form
+         */
+        template<class _Fract>
+        constexpr std::pair<typename _Fract::NaturalType, typename _Fract::NaturalType>
+        CanonicalParts(const _Fract &value) {
+            auto nominator = value.nominator();
+            auto denominator = value.denominator();
+            if constexpr (!_Fract::Normalization::IsCanonical) {
+                normalization::Reduce<_Fract>(nominator, denominator);
+            }
+            return {std::move(nominator), std::move(denominator)};
+        }
+
+        /**
+         * Copies of nominator and denominator with the denominator made positive
+         */
+        template<class _Fract>
+        constexpr std::pair<typename _Fract::NaturalType, typename _Fract::NaturalType>
+        PositiveParts(const _Fract &value) {
+            using Negate = typename _Fract::NegateOperator;
+
+            auto nominator = value.nominator();
+            auto denominator = value.denominator();
+            if (Sign<_Fract>(denominator) < 0) {
+                nominator = Negate{}(nominator);
+                denominator = Negate{}(denominator);
+            }
+            return {std::move(nominator), std::move(denominator)};
+        }
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr _NType floor(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &value) {
+        using Fract = Fractional<FRACTIONAL_TEMPLATE_PARAMS>;
+        return FloorDivide<Fract>(value.nominator(), value.denominator()).first;
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr _NType ceil(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &value) {
+        using Fract = Fractional<FRACTIONAL_TEMPLATE_PARAMS>;
+        using Plus = typename Fract::PlusOperator;
+
+        auto[quotient, remainder] = FloorDivide<Fract>(value.nominator(), value.denominator());
+        if (Sign<Fract>(remainder) != 0)
+            return Plus{}(quotient, utility::One<_NType>());
+        return quotient;
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr _NType trunc(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &value) {
+        using Fract = Fractional<FRACTIONAL_TEMPLATE_PARAMS>;
+        return typename Fract::DivideOperator{}(value.nominator(), value.denominator());
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr _NType round(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &value) {
+        using Fract = Fractional<FRACTIONAL_TEMPLATE_PARAMS>;
+        using Plus = typename Fract::PlusOperator;
+        using Minus = typename Fract::MinusOperator;
+        using Modulus = typename Fract::ModulusOperator;
+        using Equals = typename Fract::EqualOperator;
+        using Greater = typename Fract::GreaterOperator;
+        using Less = typename Fract::LessOperator;
+
+        auto[quotient, remainder] = FloorDivide<Fract>(value.nominator(), value.denominator());
+
+    /*
+     * remainder and rest = d - remainder have the sign of d, the fraction is past one half
+     * if remainder is further from zero than rest
+     */
+        auto rest = Minus{}(value.denominator(), remainder);
+        auto up = Sign<Fract>(value.denominator()) > 0 ? Greater{}(remainder, rest) : Less{}(remainder, rest);
+        if (!up && Equals{}(remainder, rest)) {
+            auto two = Plus{}(utility::One<_NType>(), utility::One<_NType>());
+            up = !Equals{}(Modulus{}(quotient, two), _NType{});
+        }
+        if (up)
+            return Plus{}(quotient, utility::One<_NType>());
+        return quotient;
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr DivMod<Fractional<FRACTIONAL_TEMPLATE_PARAMS>>
+    divmod(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &value) {
+        using Fract = Fractional<FRACTIONAL_TEMPLATE_PARAMS>;
+
+        auto[quotient, remainder] = FloorDivide<Fract>(value.nominator(), value.denominator());
+        return {std::move(quotient), Fract(std::move(remainder), _NType(value.denominator()))};
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS> abs(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &value) {
+        using Fract = Fractional<FRACTIONAL_TEMPLATE_PARAMS>;
+
+        if (Sign<Fract>(value.nominator()) * Sign<Fract>(value.denominator()) < 0)
+            return Negate(value);
+        return value;
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    mediant(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs, const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs) {
+        using Fract = Fractional<FRACTIONAL_TEMPLATE_PARAMS>;
+        using Plus = typename Fract::PlusOperator;
+
+        auto[lhs_n, lhs_d] = CanonicalParts(lhs);
+        auto[rhs_n, rhs_d] = CanonicalParts(rhs);
+        return Fract(Plus{}(lhs_n, rhs_n), Plus{}(lhs_d, rhs_d));
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    constexpr Fractional<FRACTIONAL_TEMPLATE_PARAMS>
+    between(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &lhs, const Fractional<FRACTIONAL_TEMPLATE_PARAMS> &rhs) {
+        using Fract = Fractional<FRACTIONAL_TEMPLATE_PARAMS>;
+        using Plus = typename Fract::PlusOperator;
+        using Multiply = typename Fract::MultiplyOperator;
+        using Divide = typename Fract::DivideOperator;
+        using Modulus = typename Fract::ModulusOperator;
+        using Negate = typename Fract::NegateOperator;
+        using Equals = typename Fract::EqualOperator;
+        using Greater = typename Fract::GreaterOperator;
+
+        auto ordered = Compare(lhs, rhs) <= 0;
+        auto[lo_n, lo_d] = PositiveParts(ordered ? lhs : rhs);
+        auto[hi_n, hi_d] = PositiveParts(ordered ? rhs : lhs);
+        if (Sign<Fract>(lo_n) <= 0 && Sign<Fract>(hi_n) >= 0)
+            return Fract(_NType{}, utility::One<_NType>());
+
+    /*
+     * A negative interval is mirrored to the positive one
+     */
+        auto negative = Sign<Fract>(hi_n) < 0;
+        if (negative) {
+            auto mirrored_lo_n = Negate{}(hi_n);
+            hi_n = Negate{}(lo_n);
+            lo_n = std::move(mirrored_lo_n);
+            std::swap(lo_d, hi_d);
+        }
+
+    /*
+     * 0 < lo <= hi. The original interval is the image of the current one under
+     * x -> (p0 * x + p1) / (q0 * x + q1), the convergents found so far
+     */
+        auto p0 = utility::One<_NType>(), p1 = _NType{};
+        auto q0 = _NType{}, q1 = utility::One<_NType>();
+        while (true) {
+            auto[lo_int, lo_rem] = FloorDivide<Fract>(lo_n, lo_d);
+            auto hi_int = Divide{}(hi_n, hi_d);
+            auto least = Equals{}(lo_rem, _NType{}) ? lo_int : Plus{}(lo_int, utility::One<_NType>());
+            if (!Greater{}(least, hi_int)) {
+                auto nominator = Plus{}(Multiply{}(p0, least), p1);
+                auto denominator = Plus{}(Multiply{}(q0, least), q1);
+                return Fract(negative ? Negate{}(nominator) : nominator, denominator);
+            }
+
+    /*
+     * No integer in [lo, hi]: both share the integer part and the simplest value of
+     * [1 / (hi - lo_int), 1 / (lo - lo_int)] continues the expansion
+     */
+            auto hi_rem = Modulus{}(hi_n, hi_d);
+            auto next_p = Plus{}(Multiply{}(p0, lo_int), p1);
+            auto next_q = Plus{}(Multiply{}(q0, lo_int), q1);
+            p1 = std::exchange(p0, std::move(next_p));
+            q1 = std::exchange(q0, std::move(next_q));
+
+            auto next_lo_n = std::move(hi_d);
+            hi_d = std::move(lo_rem);
+            hi_n = std::move(lo_d);
+            lo_n = std::move(next_lo_n);
+            lo_d = std::move(hi_rem);
+        }
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    void floor(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> *first, const Fractional<FRACTIONAL_TEMPLATE_PARAMS> *last,
+               _NType *out) {
+        for (; first != last; ++first, ++out) {
+            *out = floor(*first);
+        }
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    void ceil(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> *first, const Fractional<FRACTIONAL_TEMPLATE_PARAMS> *last,
+              _NType *out) {
+        for (; first != last; ++first, ++out) {
+            *out = ceil(*first);
+        }
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    void trunc(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> *first, const Fractional<FRACTIONAL_TEMPLATE_PARAMS> *last,
+               _NType *out) {
+        for (; first != last; ++first, ++out) {
+            *out = trunc(*first);
+        }
+    }
+
+    template<DECLARATION_FRACTIONAL_TEMPLATE_PARAMS>
+    void round(const Fractional<FRACTIONAL_TEMPLATE_PARAMS> *first, const Fractional<FRACTIONAL_TEMPLATE_PARAMS> *last,
+               _NType *out) {
+        for (; first != last; ++first, ++out) {
+            *out = round(*first);
+        }
+    }
+NAMESPACE_FRACTIONAL_END
+
+#endif //FRACTIONNUMBER_ROUNDING_HXX
@@ -0,0 +1,281 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_SERIALIZATION_HPP
+#define FRACTIONNUMBER_SERIALIZATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "fractional.hpp"
+#include "fractionvector.hpp"
+
+#if __has_include(<sys/mman.h>)
+#define FRACTIONAL_HAS_MMAP 1
+#else
+#define FRACTIONAL_HAS_MMAP 0
+#endif
+
+/**
+ * Binary persistence of fractions with built-in NaturalType. Values are written as stored,
+ * readers construct _Fract from them, so the Normalization of the reading type applies.
+ *
+ * Stream format, written by Writer and read by Reader, independent of byte order:
+ *  header  "FRB1", NaturalType width in bytes, 1 if NaturalType is signed
+ *  block   kind, count (varint), payload size (varint), payload, CRC-32C of the block so far
+ *  end     kind End, total count (varint), CRC-32C of the two
+ * Integers are LEB128 varints, zig-zag encoded if NaturalType is signed. A Plain payload holds
+ * nominator and denominator of every value, a Shared payload the denominator once and then
+ * the nominators; Writer picks Shared for every block whose values have one denominator.
+ *
+ * Columnar format, written by write_columns and read in place by ColumnView and MappedColumns:
+ * ColumnHeader, the nominator column and the denominator column, absent if every value has
+ * the same denominator. Columns are fixed-width arrays in host byte order starting at
+ * multiples of 64 bytes, so a mapped file is read as two arrays without copying.
+ */
+namespace fractional::binary {
+    /**
+     * Malformed, corrupted or truncated input
+     */
+    struct FormatError : std::runtime_error {
+        using std::runtime_error::runtime_error;
+    };
+
+    /**
+     * CRC-32C (Castagnoli) of data continuing crc, SSE 4.2 instruction when the processor has it
+     */
+    inline std::uint32_t crc32c(const void *data, std::size_t size, std::uint32_t crc = 0) noexcept;
+
+    enum class BlockKind : std::uint8_t {
+        Plain = 0,
+        Shared = 1,
+        End = 2
+    };
+
+    template<class _Fract>
+    class Writer {
+    public:
+        using NaturalType = typename _Fract::NaturalType;
+
+        static_assert(std::is_integral_v<NaturalType>, "binary format requires built-in NaturalType");
+
+        /**
+         * Writes the stream header, values are buffered in blocks of block_size
+         */
+        explicit Writer(std::ostream &out, std::size_t block_size = 4096);
+
+        Writer(const Writer &) = delete;
+
+        Writer &operator=(const Writer &) = delete;
+
+        void write(const _Fract &value);
+
+        void write(const _Fract *values, std::size_t size);
+
+        void write(const FractionVector<NaturalType> &values);
+
+        /**
+         * Writes the buffered block and the end marker, nothing may be written afterwards.
+         * A stream without end marker is reported truncated by Reader.
+         */
+        void finish();
+
+        /**
+         * Values written so far
+         */
+        std::size_t count() const noexcept;
+
+    private:
+        void push(const NaturalType &nominator, const NaturalType &denominator);
+
+        void flush();
+
+        std::ostream &out_;
+        std::size_t block_size_;
+        std::size_t count_ = 0;
+        bool finished_ = false;
+        std::vector<NaturalType> nominators_;
+        std::vector<NaturalType> denominators_;
+        std::vector<unsigned char> buffer_;
+    };
+
+    template<class _Fract>
+    class Reader {
+    public:
+        using NaturalType = typename _Fract::NaturalType;
+
+        static_assert(std::is_integral_v<NaturalType>, "binary format requires built-in NaturalType");
+
+        /**
+         * Reads the stream header. Streams written with another signedness are rejected,
+         * values written with a wider type must fit NaturalType.
+         */
+        explicit Reader(std::istream &in);
+
+        /**
+         * Reads up to capacity values into out, every block is verified before it is decoded
+         * @return number of values read, less than capacity only at the end of the stream
+         * @throw FormatError on checksum mismatch, malformed or truncated input
+         */
+        std::size_t read(_Fract *out, std::size_t capacity);
+
+        /**
+         * Appends up to capacity lanes to out as stored, without constructing _Fract
+         */
+        std::size_t read(FractionVector<NaturalType> &out, std::size_t capacity);
+
+        /**
+         * True once the end marker has been read
+         */
+        bool done() const noexcept;
+
+    private:
+        template<class _Sink>
+        std::size_t decode(std::size_t capacity, _Sink sink);
+
+        bool load();
+
+        std::istream &in_;
+        std::vector<unsigned char> payload_;
+        const unsigned char *position_ = nullptr;
+        std::size_t remaining_ = 0;
+        std::size_t count_ = 0;
+        bool shared_ = false;
+        bool done_ = false;
+        NaturalType denominator_{};
+    };
+
+    /**
+     * Layout of the first 64 bytes of a columnar file, host byte order
+     */
+    struct ColumnHeader {
+        char magic[8];
+        std::uint32_t byte_order;
+        std::uint8_t width;
+        std::uint8_t is_signed;
+        std::uint8_t shared;
+        std::uint8_t reserved;
+        std::uint64_t count;
+        std::uint64_t nominators_offset;
+
+        /**
+         * Zero if shared
+         */
+        std::uint64_t denominators_offset;
+
+        /**
+         * Bits of the denominator of every value if shared
+         */
+        std::uint64_t shared_denominator;
+        std::uint32_t nominators_crc;
+        std::uint32_t denominators_crc;
+
+        /**
+         * CRC-32C of every field above
+         */
+        std::uint32_t header_crc;
+        std::uint32_t padding;
+    };
+
+    static_assert(sizeof(ColumnHeader) == 64, "ColumnHeader must be 64 bytes");
+
+    /**
+     * Writes size lanes in columnar format, the denominator column is dropped if all lanes share one
+     */
+    template<class _NaturalType>
+    void write_columns(std::ostream &out, const _NaturalType *nominators, const _NaturalType *denominators,
+                       std::size_t size);
+
+    template<class _NaturalType>
+    void write_columns(std::ostream &out, const FractionVector<_NaturalType> &values);
+
+    /**
+     * Non-owning view of a columnar image in memory, the image must outlive the view
+     */
+    template<class _NaturalType>
+    class ColumnView {
+    public:
+        using NaturalType = _NaturalType;
+
+        static_assert(std::is_integral_v<NaturalType> && sizeof(NaturalType) <= 8,
+                      "columns hold built-in integers up to 64 bits");
+
+        ColumnView() = default;
+
+        /**
+         * Checks the header and that the columns lie within [data, data + size), column
+         * checksums are left to verify() so that opening does not touch every page
+         * @throw FormatError if the image is not a columnar file of NaturalType
+         */
+        ColumnView(const void *data, std::size_t size);
+
+        std::size_t size() const noexcept;
+
+        const NaturalType *nominators() const noexcept;
+
+        /**
+         * nullptr if shared()
+         */
+        const NaturalType *denominators() const noexcept;
+
+        /**
+         * True if every value has the denominator of the header and there is no denominator column
+         */
+        bool shared() const noexcept;
+
+        NaturalType denominator(std::size_t i) const noexcept;
+
+        /**
+         * i-th value, normalized by the constructor of _Fract
+         */
+        template<class _Fract = Fractional<NaturalType>>
+        _Fract at(std::size_t i) const;
+
+        /**
+         * Compares both columns with their checksums
+         */
+        bool verify() const noexcept;
+
+    private:
+        const ColumnHeader *header_ = nullptr;
+        const NaturalType *nominators_ = nullptr;
+        const NaturalType *denominators_ = nullptr;
+        NaturalType denominator_{};
+    };
+
+#if FRACTIONAL_HAS_MMAP
+    /**
+     * Read-only mapping of a columnar file, the view is valid while the object lives
+     */
+    template<class _NaturalType>
+    class MappedColumns : public ColumnView<_NaturalType> {
+    public:
+        /**
+         * @throw std::system_error if the file cannot be opened or mapped, FormatError like ColumnView
+         */
+        explicit MappedColumns(const std::string &path);
+
+        MappedColumns(MappedColumns &&other) noexcept;
+
+        MappedColumns &operator=(MappedColumns &&other) noexcept;
+
+        ~MappedColumns();
+
+    private:
+        void unmap() noexcept;
+
+        void *address_ = nullptr;
+        std::size_t length_ = 0;
+    };
+#endif
+}
+
+#include "serialization.hxx"
+
+#endif //FRACTIONNUMBER_SERIALIZATION_HPP
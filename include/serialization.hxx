@@ -0,0 +1,554 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_SERIALIZATION_HXX
+#define FRACTIONNUMBER_SERIALIZATION_HXX
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <system_error>
+#include "serialization.hpp"
+
+#if FRACTIONAL_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fractional::binary {
+    namespace {
+        constexpr std::array<std::uint32_t, 256> MakeCrcTable() noexcept {
+            std::array<std::uint32_t, 256> table{};
+            for (std::uint32_t i = 0; i < 256; ++i) {
+                auto crc = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    crc = (crc >> 1u) ^ (0x82F63B78u & (0u - (crc & 1u)));
+                }
+                table[i] = crc;
+            }
+            return table;
+        }
+
+        constexpr auto CrcTable = MakeCrcTable();
+
+        inline std::uint32_t Crc32cSoftware(const unsigned char *data, std::size_t size, std::uint32_t crc) noexcept {
+            for (std::size_t i = 0; i < size; ++i) {
+                crc = CrcTable[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8u);
+            }
+            return crc;
+        }
+
+#if defined(__x86_64__)
+        __attribute__((target("sse4.2")))
+        inline std::uint32_t Crc32cHardware(const unsigned char *data, std::size_t size, std::uint32_t crc) noexcept {
+            unsigned long long wide = crc;
+            for (; size >= 8; data += 8, size -= 8) {
+                unsigned long long word;
+                std::memcpy(&word, data, 8);
+                wide = __builtin_ia32_crc32di(wide, word);
+            }
+            crc = std::uint32_t(wide);
+            for (; size > 0; ++data, --size) {
+                crc = __builtin_ia32_crc32qi(crc, *data);
+            }
+            return crc;
+        }
+#endif
+
+        /**
+         * Bytes of the longest LEB128 varint of _UType
+         */
+        template<class _UType>
+        constexpr std::size_t MaxVarint = (std::numeric_limits<_UType>::digits + 6) / 7;
+
+        /**
+         * Bytes of the longest varint of any NaturalType a stream may be written with
+         */
+        constexpr std::size_t MaxStreamVarint = MaxVarint<unsigned long long>;
+
+        template<class _UType>
+        unsigned char *PutVarint(unsigned char *out, _UType value) noexcept {
+            while (value >= 0x80u) {
+                *out++ = static_cast<unsigned char>(value | 0x80u);
+                value >>= 7u;
+            }
+            *out++ = static_cast<unsigned char>(value);
+            return out;
+        }
+
+        /**
+         * @return false if input ends inside the varint or its value does not fit _UType
+         */
+        template<class _UType>
+        bool GetVarint(const unsigned char *&in, const unsigned char *end, _UType &value) noexcept {
+            constexpr unsigned digits = std::numeric_limits<_UType>::digits;
+            value = 0;
+            for (unsigned shift = 0; in != end; shift += 7) {
+                auto byte = *in++;
+                auto bits = _UType(byte & 0x7Fu);
+                if (shift >= digits || (digits - shift < 7 && (bits >> (digits - shift)) != 0))
+                    return false;
+                value |= _UType(bits << shift);
+                if ((byte & 0x80u) == 0)
+                    return true;
+            }
+            return false;
+        }
+
+        template<class _NaturalType>
+        std::make_unsigned_t<_NaturalType> ZigZag(const _NaturalType &value) noexcept {
+            using UType = std::make_unsigned_t<_NaturalType>;
+            if constexpr (std::is_signed_v<_NaturalType>) {
+                return UType(UType(value) << 1u) ^ UType(UType{} - UType(value < 0));
+            } else {
+                return value;
+            }
+        }
+
+        template<class _NaturalType>
+        _NaturalType UnZigZag(const std::make_unsigned_t<_NaturalType> &value) noexcept {
+            using UType = std::make_unsigned_t<_NaturalType>;
+            if constexpr (std::is_signed_v<_NaturalType>) {
+                return _NaturalType(UType(value >> 1u) ^ UType(UType{} - UType(value & 1u)));
+            } else {
+                return value;
+            }
+        }
+
+        template<class _NaturalType>
+        _NaturalType GetValue(const unsigned char *&in, const unsigned char *end) {
+            std::make_unsigned_t<_NaturalType> value;
+            if (!GetVarint(in, end, value))
+                throw FormatError("varint out of range or past the end of its block");
+            return UnZigZag<_NaturalType>(value);
+        }
+
+        inline void PutCrc(std::ostream &out, std::uint32_t crc) {
+            unsigned char bytes[4] = {static_cast<unsigned char>(crc), static_cast<unsigned char>(crc >> 8u),
+                                      static_cast<unsigned char>(crc >> 16u), static_cast<unsigned char>(crc >> 24u)};
+            out.write(reinterpret_cast<const char *>(bytes), 4);
+        }
+
+        inline std::uint32_t GetCrc(std::istream &in) {
+            unsigned char bytes[4];
+            if (!in.read(reinterpret_cast<char *>(bytes), 4))
+                throw FormatError("truncated stream");
+            return std::uint32_t(bytes[0]) | std::uint32_t(bytes[1]) << 8u |
+                   std::uint32_t(bytes[2]) << 16u | std::uint32_t(bytes[3]) << 24u;
+        }
+
+        constexpr char StreamMagic[4] = {'F', 'R', 'B', '1'};
+        constexpr char ColumnMagic[8] = {'F', 'R', 'C', 'O', 'L', '1', '\0', '\0'};
+        constexpr std::uint32_t ByteOrderMark = 0x01020304u;
+        constexpr std::uint64_t ColumnAlignment = 64;
+    }
+
+    inline std::uint32_t crc32c(const void *data, std::size_t size, std::uint32_t crc) noexcept {
+        auto bytes = static_cast<const unsigned char *>(data);
+#if defined(__x86_64__)
+        static const bool hardware = [] {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse4.2") != 0;
+        }();
+        if (hardware)
+            return ~Crc32cHardware(bytes, size, ~crc);
+#endif
+        return ~Crc32cSoftware(bytes, size, ~crc);
+    }
+
+    template<class _Fract>
+    Writer<_Fract>::Writer(std::ostream &out, std::size_t block_size)
+            : out_(out), block_size_(std::max<std::size_t>(1, block_size)) {
+        nominators_.reserve(block_size_);
+        denominators_.reserve(block_size_);
+        out_.write(StreamMagic, sizeof(StreamMagic));
+        out_.put(char(sizeof(NaturalType)));
+        out_.put(char(std::is_signed_v<NaturalType>));
+    }
+
+    template<class _Fract>
+    void Writer<_Fract>::write(const _Fract &value) {
+        push(value.nominator(), value.denominator());
+    }
+
+    template<class _Fract>
+    void Writer<_Fract>::write(const _Fract *values, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i) {
+            push(values[i].nominator(), values[i].denominator());
+        }
+    }
+
+    template<class _Fract>
+    void Writer<_Fract>::write(const FractionVector<NaturalType> &values) {
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            push(values.nominators()[i], values.denominators()[i]);
+        }
+    }
+
+    template<class _Fract>
+    void Writer<_Fract>::finish() {
+        if (finished_)
+            return;
+        flush();
+        unsigned char end[1 + MaxStreamVarint] = {static_cast<unsigned char>(BlockKind::End)};
+        auto size = std::size_t(PutVarint(end + 1, std::uint64_t(count_)) - end);
+        out_.write(reinterpret_cast<const char *>(end), std::streamsize(size));
+        PutCrc(out_, crc32c(end, size));
+        out_.flush();
+        finished_ = true;
+    }
+
+    template<class _Fract>
+    std::size_t Writer<_Fract>::count() const noexcept {
+        return count_;
+    }
+
+    template<class _Fract>
+    void Writer<_Fract>::push(const NaturalType &nominator, const NaturalType &denominator) {
+        if (finished_)
+            throw std::logic_error("Writer is finished");
+        nominators_.push_back(nominator);
+        denominators_.push_back(denominator);
+        ++count_;
+        if (nominators_.size() == block_size_) {
+            flush();
+        }
+    }
+
+    template<class _Fract>
+    void Writer<_Fract>::flush() {
+        using UType = std::make_unsigned_t<NaturalType>;
+
+        auto size = nominators_.size();
+        if (size == 0)
+            return;
+        auto denominator = denominators_.front();
+        bool shared = size > 1 && std::all_of(denominators_.begin(), denominators_.end(),
+                                              [&](const NaturalType &value) { return value == denominator; });
+
+        buffer_.resize((2 * size + 1) * MaxVarint<UType>);
+        auto out = buffer_.data();
+        if (shared) {
+            out = PutVarint(out, ZigZag(denominator));
+            for (auto &nominator : nominators_) {
+                out = PutVarint(out, ZigZag(nominator));
+            }
+        } else {
+            for (std::size_t i = 0; i < size; ++i) {
+                out = PutVarint(out, ZigZag(nominators_[i]));
+                out = PutVarint(out, ZigZag(denominators_[i]));
+            }
+        }
+        auto payload = std::size_t(out - buffer_.data());
+
+        unsigned char header[1 + 2 * MaxStreamVarint] = {
+                static_cast<unsigned char>(shared ? BlockKind::Shared : BlockKind::Plain)};
+        auto end = PutVarint(PutVarint(header + 1, std::uint64_t(size)), std::uint64_t(payload));
+        auto header_size = std::size_t(end - header);
+
+        out_.write(reinterpret_cast<const char *>(header), std::streamsize(header_size));
+        out_.write(reinterpret_cast<const char *>(buffer_.data()), std::streamsize(payload));
+        PutCrc(out_, crc32c(buffer_.data(), payload, crc32c(header, header_size)));
+        nominators_.clear();
+        denominators_.clear();
+    }
+
+    template<class _Fract>
+    Reader<_Fract>::Reader(std::istream &in) : in_(in) {
+        char header[sizeof(StreamMagic) + 2];
+        if (!in_.read(header, sizeof(header)) || !std::equal(StreamMagic, StreamMagic + sizeof(StreamMagic), header))
+            throw FormatError("not a fraction stream");
+        if (bool(header[sizeof(StreamMagic) + 1]) != std::is_signed_v<NaturalType>)
+            throw FormatError("stream was written with another signedness");
+    }
+
+    template<class _Fract>
+    std::size_t Reader<_Fract>::read(_Fract *out, std::size_t capacity) {
+        return decode(capacity, [&](NaturalType nominator, NaturalType denominator) {
+            *out++ = _Fract{std::move(nominator), std::move(denominator)};
+        });
+    }
+
+    template<class _Fract>
+    std::size_t Reader<_Fract>::read(FractionVector<NaturalType> &out, std::size_t capacity) {
+        return decode(capacity, [&](const NaturalType &nominator, const NaturalType &denominator) {
+            out.push_back(nominator, denominator);
+        });
+    }
+
+    template<class _Fract>
+    bool Reader<_Fract>::done() const noexcept {
+        return done_;
+    }
+
+    template<class _Fract>
+    template<class _Sink>
+    std::size_t Reader<_Fract>::decode(std::size_t capacity, _Sink sink) {
+        std::size_t read = 0;
+        while (read < capacity) {
+            if (remaining_ == 0 && (done_ || !load()))
+                break;
+
+            auto end = payload_.data() + payload_.size();
+            auto take = std::min(remaining_, capacity - read);
+            for (std::size_t i = 0; i < take; ++i) {
+                auto nominator = GetValue<NaturalType>(position_, end);
+                auto denominator = shared_ ? denominator_ : GetValue<NaturalType>(position_, end);
+                sink(std::move(nominator), std::move(denominator));
+            }
+            read += take;
+            remaining_ -= take;
+            count_ += take;
+            if (remaining_ == 0 && position_ != end)
+                throw FormatError("block payload is longer than its values");
+        }
+        return read;
+    }
+
+    template<class _Fract>
+    bool Reader<_Fract>::load() {
+        unsigned char header[1 + 2 * MaxStreamVarint];
+        std::size_t size = 0;
+        auto next = [&] {
+            auto byte = in_.get();
+            if (byte == std::istream::traits_type::eof())
+                throw FormatError("truncated stream");
+            header[size++] = static_cast<unsigned char>(byte);
+            return static_cast<unsigned char>(byte);
+        };
+        auto varint = [&] {
+            auto first = header + size;
+            for (std::size_t i = 0; (next() & 0x80u) != 0; ++i) {
+                if (i + 1 == MaxStreamVarint)
+                    throw FormatError("varint too long");
+            }
+            const unsigned char *in = first;
+            std::uint64_t value;
+            if (!GetVarint(in, header + size, value))
+                throw FormatError("varint out of range");
+            return value;
+        };
+
+        auto kind = BlockKind(next());
+        if (kind == BlockKind::End) {
+            auto total = varint();
+            if (GetCrc(in_) != crc32c(header, size))
+                throw FormatError("checksum mismatch");
+            if (total != count_)
+                throw FormatError("stream ends after a different number of values");
+            done_ = true;
+            return false;
+        }
+        if (kind != BlockKind::Plain && kind != BlockKind::Shared)
+            throw FormatError("unknown block kind");
+
+        auto count = varint();
+        auto payload = varint();
+        if (count == 0 || count > std::numeric_limits<std::size_t>::max() / (4 * MaxStreamVarint) ||
+            payload > (2 * count + 1) * MaxStreamVarint)
+            throw FormatError("block size out of range");
+
+        payload_.resize(std::size_t(payload));
+        if (!in_.read(reinterpret_cast<char *>(payload_.data()), std::streamsize(payload)))
+            throw FormatError("truncated stream");
+        if (GetCrc(in_) != crc32c(payload_.data(), payload_.size(), crc32c(header, size)))
+            throw FormatError("checksum mismatch");
+
+        position_ = payload_.data();
+        remaining_ = std::size_t(count);
+        shared_ = kind == BlockKind::Shared;
+        if (shared_) {
+            denominator_ = GetValue<NaturalType>(position_, payload_.data() + payload_.size());
+        }
+        return true;
+    }
+
+    template<class _NaturalType>
+    void write_columns(std::ostream &out, const _NaturalType *nominators, const _NaturalType *denominators,
+                       std::size_t size) {
+        static_assert(std::is_integral_v<_NaturalType> && sizeof(_NaturalType) <= 8,
+                      "columns hold built-in integers up to 64 bits");
+        using UType = std::make_unsigned_t<_NaturalType>;
+
+        auto align = [](std::uint64_t offset) {
+            return (offset + ColumnAlignment - 1) / ColumnAlignment * ColumnAlignment;
+        };
+        auto bytes = std::uint64_t(size) * sizeof(_NaturalType);
+        bool shared = size > 0 && std::all_of(denominators + 1, denominators + size,
+                                              [&](const _NaturalType &value) { return value == denominators[0]; });
+
+        ColumnHeader header{};
+        std::memcpy(header.magic, ColumnMagic, sizeof(ColumnMagic));
+        header.byte_order = ByteOrderMark;
+        header.width = sizeof(_NaturalType);
+        header.is_signed = std::is_signed_v<_NaturalType>;
+        header.shared = shared;
+        header.count = size;
+        header.nominators_offset = sizeof(ColumnHeader);
+        header.denominators_offset = shared ? 0 : align(header.nominators_offset + bytes);
+        header.shared_denominator = shared ? std::uint64_t(UType(denominators[0])) : 0;
+        header.nominators_crc = crc32c(nominators, std::size_t(bytes));
+        header.denominators_crc = shared ? 0 : crc32c(denominators, std::size_t(bytes));
+        header.header_crc = crc32c(&header, offsetof(ColumnHeader, header_crc));
+
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(nominators), std::streamsize(bytes));
+        if (!shared) {
+            char padding[ColumnAlignment] = {};
+            out.write(padding, std::streamsize(header.denominators_offset - header.nominators_offset - bytes));
+            out.write(reinterpret_cast<const char *>(denominators), std::streamsize(bytes));
+        }
+    }
+
+    template<class _NaturalType>
+    void write_columns(std::ostream &out, const FractionVector<_NaturalType> &values) {
+        write_columns(out, values.nominators(), values.denominators(), values.size());
+    }
+
+    template<class _NaturalType>
+    ColumnView<_NaturalType>::ColumnView(const void *data, std::size_t size) {
+        if (size < sizeof(ColumnHeader) || reinterpret_cast<std::uintptr_t>(data) % alignof(ColumnHeader) != 0)
+            throw FormatError("not a columnar image");
+        auto header = static_cast<const ColumnHeader *>(data);
+        if (std::memcmp(header->magic, ColumnMagic, sizeof(ColumnMagic)) != 0)
+            throw FormatError("not a columnar image");
+        if (header->byte_order != ByteOrderMark)
+            throw FormatError("columnar image has another byte order");
+        if (header->header_crc != crc32c(header, offsetof(ColumnHeader, header_crc)))
+            throw FormatError("checksum mismatch");
+        if (header->width != sizeof(NaturalType) || bool(header->is_signed) != std::is_signed_v<NaturalType>)
+            throw FormatError("columns hold another NaturalType");
+
+    /*
+     * Each column must be aligned and lie within the image, count * width must not wrap
+     */
+        auto fits = [&](std::uint64_t offset) {
+            return offset % ColumnAlignment == 0 && offset <= size &&
+                   header->count <= (size - offset) / sizeof(NaturalType);
+        };
+        bool shared = header->shared != 0;
+        if (!fits(header->nominators_offset) || (shared ? header->denominators_offset != 0
+                                                        : !fits(header->denominators_offset)))
+            throw FormatError("columns out of the image");
+
+        auto bytes = static_cast<const unsigned char *>(data);
+        header_ = header;
+        nominators_ = reinterpret_cast<const NaturalType *>(bytes + header->nominators_offset);
+        denominators_ = shared ? nullptr : reinterpret_cast<const NaturalType *>(bytes + header->denominators_offset);
+        denominator_ = NaturalType(std::make_unsigned_t<NaturalType>(header->shared_denominator));
+    }
+
+    template<class _NaturalType>
+    std::size_t ColumnView<_NaturalType>::size() const noexcept {
+        return header_ ? std::size_t(header_->count) : 0;
+    }
+
+    template<class _NaturalType>
+    const _NaturalType *ColumnView<_NaturalType>::nominators() const noexcept {
+        return nominators_;
+    }
+
+    template<class _NaturalType>
+    const _NaturalType *ColumnView<_NaturalType>::denominators() const noexcept {
+        return denominators_;
+    }
+
+    template<class _NaturalType>
+    bool ColumnView<_NaturalType>::shared() const noexcept {
+        return header_ && header_->shared != 0;
+    }
+
+    template<class _NaturalType>
+    _NaturalType ColumnView<_NaturalType>::denominator(std::size_t i) const noexcept {
+        return denominators_ ? denominators_[i] : denominator_;
+    }
+
+    template<class _NaturalType>
+    template<class _Fract>
+    _Fract ColumnView<_NaturalType>::at(std::size_t i) const {
+        return _Fract{nominators_[i], denominator(i)};
+    }
+
+    template<class _NaturalType>
+    bool ColumnView<_NaturalType>::verify() const noexcept {
+        if (!header_)
+            return true;
+        auto bytes = size() * sizeof(NaturalType);
+        return crc32c(nominators_, bytes) == header_->nominators_crc &&
+               (!denominators_ || crc32c(denominators_, bytes) == header_->denominators_crc);
+    }
+
+#if FRACTIONAL_HAS_MMAP
+    template<class _NaturalType>
+    MappedColumns<_NaturalType>::MappedColumns(const std::string &path) {
+        auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(), path);
+
+        struct stat status{};
+        if (::fstat(fd, &status) != 0) {
+            auto error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), path);
+        }
+        auto length = std::size_t(status.st_size);
+        auto address = length > 0 ? ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+        auto error = errno;
+        ::close(fd);
+        if (address == MAP_FAILED)
+            throw std::system_error(error, std::generic_category(), path);
+        address_ = address;
+        length_ = length;
+
+        try {
+            ColumnView<_NaturalType>::operator=(ColumnView<_NaturalType>(address_, length_));
+        } catch (...) {
+            unmap();
+            throw;
+        }
+    }
+
+    template<class _NaturalType>
+    MappedColumns<_NaturalType>::MappedColumns(MappedColumns &&other) noexcept
+            : ColumnView<_NaturalType>(other), address_(other.address_), length_(other.length_) {
+        static_cast<ColumnView<_NaturalType> &>(other) = ColumnView<_NaturalType>();
+        other.address_ = nullptr;
+        other.length_ = 0;
+    }
+
+    template<class _NaturalType>
+    MappedColumns<_NaturalType> &MappedColumns<_NaturalType>::operator=(MappedColumns &&other) noexcept {
+        if (this != &other) {
+            unmap();
+            ColumnView<_NaturalType>::operator=(other);
+            address_ = other.address_;
+            length_ = other.length_;
+            static_cast<ColumnView<_NaturalType> &>(other) = ColumnView<_NaturalType>();
+            other.address_ = nullptr;
+            other.length_ = 0;
+        }
+        return *this;
+    }
+
+    template<class _NaturalType>
+    MappedColumns<_NaturalType>::~MappedColumns() {
+        unmap();
+    }
+
+    template<class _NaturalType>
+    void MappedColumns<_NaturalType>::unmap() noexcept {
+        if (address_)
+            ::munmap(address_, length_);
+        address_ = nullptr;
+        length_ = 0;
+    }
+#endif
+}
+
+#endif //FRACTIONNUMBER_SERIALIZATION_HXX
@@ -0,0 +1,35 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_SORTING_HPP
+#define FRACTIONNUMBER_SORTING_HPP
+
+#include <cstddef>
+#include "fractional.hpp"
+
+/**
+ * Exact sorting of large spans of Fractional. Correctly rounded conversion to double is
+ * monotone, so values are radix sorted by the bits of their double, which order like the
+ * doubles themselves, and only runs of values with the same double, distinct rationals
+ * closer than one rounding step, are sorted again with the exact comparison.
+ */
+NAMESPACE_FRACTIONAL_BEGIN
+    struct SortOptions {
+        /**
+         * Shorter spans go to std::sort with the exact comparison
+         */
+        std::size_t radix_threshold = 1024;
+    };
+
+    /**
+     * Sorts [first, last) ascending by value, the order of equal values is unspecified.
+     * Built-in NaturalType only. Allocates 32 bytes of keys per value and a copy of the span.
+     */
+    template<class _Fract>
+    void radix_sort(_Fract *first, _Fract *last, const SortOptions &options = {});
+NAMESPACE_FRACTIONAL_END
+
+#include "sorting.hxx"
+
+#endif //FRACTIONNUMBER_SORTING_HPP
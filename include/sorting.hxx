@@ -0,0 +1,108 @@
+//
+// Created by Linux Oid on 07.05.2020.
+//
+
+#ifndef FRACTIONNUMBER_SORTING_HXX
+#define FRACTIONNUMBER_SORTING_HXX
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+#include "sorting.hpp"
+
+NAMESPACE_FRACTIONAL_BEGIN
+    namespace {
+        /**
+         * Bits of x that order like x as unsigned integers: negative values have every bit flipped,
+         * others only the sign bit
+         */
+        inline std::uint64_t OrderedBits(double x) noexcept {
+            std::uint64_t bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            return (bits >> 63u) != 0 ? ~bits : bits | (std::uint64_t(1) << 63u);
+        }
+
+        constexpr unsigned RadixBits = 11;
+        constexpr std::size_t RadixBuckets = std::size_t(1) << RadixBits;
+        constexpr unsigned RadixPasses = (64 + RadixBits - 1) / RadixBits;
+
+        constexpr std::size_t RadixDigit(std::uint64_t key, unsigned pass) noexcept {
+            return std::size_t(key >> (pass * RadixBits)) & (RadixBuckets - 1);
+        }
+    }
+
+    template<class _Fract>
+    void radix_sort(_Fract *first, _Fract *last, const SortOptions &options) {
+        static_assert(std::is_integral_v<typename _Fract::NaturalType>, "radix_sort requires built-in NaturalType");
+
+        auto less = [](const _Fract &lhs, const _Fract &rhs) {
+            return Compare(lhs, rhs) < 0;
+        };
+        auto size = std::size_t(last - first);
+        if (size < std::max<std::size_t>(2, options.radix_threshold)) {
+            std::sort(first, last, less);
+            return;
+        }
+
+    /*
+     * One pass over the values computes the keys and the digit histograms of every radix pass
+     */
+        std::vector<std::uint64_t> keys(size), scattered_keys(size);
+        std::vector<std::size_t> indices(size), scattered_indices(size);
+        std::vector<std::size_t> counts(RadixPasses * RadixBuckets);
+        for (std::size_t i = 0; i < size; ++i) {
+            keys[i] = OrderedBits(static_cast<double>(first[i]) + 0.0);
+            indices[i] = i;
+            for (unsigned pass = 0; pass < RadixPasses; ++pass) {
+                ++counts[pass * RadixBuckets + RadixDigit(keys[i], pass)];
+            }
+        }
+
+    /*
+     * Least significant digit first, a pass whose digit is the same in every key is skipped
+     */
+        for (unsigned pass = 0; pass < RadixPasses; ++pass) {
+            auto count = counts.data() + pass * RadixBuckets;
+            if (count[RadixDigit(keys[0], pass)] == size)
+                continue;
+
+            std::size_t offset = 0;
+            for (std::size_t bucket = 0; bucket < RadixBuckets; ++bucket) {
+                auto bucket_size = count[bucket];
+                count[bucket] = offset;
+                offset += bucket_size;
+            }
+            for (std::size_t i = 0; i < size; ++i) {
+                auto position = count[RadixDigit(keys[i], pass)]++;
+                scattered_keys[position] = keys[i];
+                scattered_indices[position] = indices[i];
+            }
+            keys.swap(scattered_keys);
+            indices.swap(scattered_indices);
+        }
+
+        std::vector<_Fract> values;
+        values.reserve(size);
+        for (auto index : indices) {
+            values.push_back(first[index]);
+        }
+        std::copy(values.begin(), values.end(), first);
+
+    /*
+     * Distinct values rounding to the same double are ordered exactly
+     */
+        for (std::size_t begin = 0, end; begin < size; begin = end) {
+            end = begin + 1;
+            while (end < size && keys[end] == keys[begin]) {
+                ++end;
+            }
+            if (end - begin > 1) {
+                std::sort(first + begin, first + end, less);
+            }
+        }
+    }
+NAMESPACE_FRACTIONAL_END
+
+#endif //FRACTIONNUMBER_SORTING_HXX
@@ -5,43 +5,387 @@
 #ifndef FRACTIONNUMBER_UTILITY_HPP
 #define FRACTIONNUMBER_UTILITY_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
 namespace fractional::utility {
     using std::declval;
 
+    /**
+     * @return NaturalType one built from the default constructed zero
+     */
+    template<class _NType>
+    constexpr _NType One() {
+        auto zero = _NType{};
+        return ++zero;
+    }
+
     template<class Op, auto Checker>
     struct OperatorWrapper;
 
+    /**
+     * Applies Checker before Op. Checkers returning OpType compute the checked
+     * result themselves, it is returned directly without calling Op again.
+     */
     template<template<class> class Op, class OpType, auto Checker>
     struct OperatorWrapper<Op<OpType>, Checker> {
-        auto operator()(const OpType &lhs, const OpType &rhs) noexcept(noexcept(Checker(lhs, rhs))) {
-            Checker(lhs, rhs);
-            return Op<OpType>{}(lhs, rhs);
+        constexpr auto operator()(const OpType &lhs, const OpType &rhs) noexcept(noexcept(Checker(lhs, rhs))) {
+            if constexpr (std::is_same_v<decltype(Checker(lhs, rhs)), OpType>) {
+                return Checker(lhs, rhs);
+            } else {
+                Checker(lhs, rhs);
+                return Op<OpType>{}(lhs, rhs);
+            }
         }
 
-        auto operator()(const OpType &lhs) noexcept(noexcept(Checker(lhs))) {
-            Checker(lhs);
-            return Op<OpType>{}(lhs);
+        constexpr auto operator()(const OpType &lhs) noexcept(noexcept(Checker(lhs))) {
+            if constexpr (std::is_same_v<decltype(Checker(lhs)), OpType>) {
+                return Checker(lhs);
+            } else {
+                Checker(lhs);
+                return Op<OpType>{}(lhs);
+            }
         }
     };
 
-    template<class _NType, class _OverflowChecker>
-    constexpr _NType gcd(const _NType &lhs, const _NType &rhs) noexcept(
-    noexcept(_OverflowChecker::CheckNegate(declval<_NType>())) &&
-    noexcept(_OverflowChecker::CheckModulus(declval<_NType>(), declval<_NType>())) &&
-    noexcept(typename _OverflowChecker::EqualOperator{}(declval<_NType>(), declval<_NType>())) &&
-    noexcept(typename _OverflowChecker::ModulusOperator{}(declval<_NType>(), declval<_NType>())) &&
-    noexcept(typename _OverflowChecker::NegateOperator{}(declval<_NType>()))
-    ) {
+    /**
+     * Allocator returning storage aligned to _Alignment bytes, used for arrays fed to vector kernels
+     */
+    template<class T, std::size_t _Alignment = 64>
+    struct AlignedAllocator {
+        static_assert(_Alignment >= alignof(T) && (_Alignment & (_Alignment - 1)) == 0,
+                      "_Alignment must be a power of two not less than alignof(T)");
+
+        using value_type = T;
+
+        template<class U>
+        struct rebind {
+            using other = AlignedAllocator<U, _Alignment>;
+        };
+
+        AlignedAllocator() noexcept = default;
+
+        template<class U>
+        AlignedAllocator(const AlignedAllocator<U, _Alignment> &) noexcept {}
+
+        T *allocate(std::size_t size) {
+            if (size > std::numeric_limits<std::size_t>::max() / sizeof(T))
+                throw std::bad_array_new_length{};
+            return static_cast<T *>(::operator new(size * sizeof(T), std::align_val_t{_Alignment}));
+        }
+
+        void deallocate(T *pointer, std::size_t) noexcept {
+            ::operator delete(pointer, std::align_val_t{_Alignment});
+        }
+
+        template<class U>
+        bool operator==(const AlignedAllocator<U, _Alignment> &) const noexcept {
+            return true;
+        }
+
+        template<class U>
+        bool operator!=(const AlignedAllocator<U, _Alignment> &) const noexcept {
+            return false;
+        }
+    };
+
+    /**
+     * Built-in integer of twice the width and the same signedness, if there is one
+     */
+    template<class _NType, typename = void>
+    struct Wider {
+    };
+
+    template<class _NType>
+    struct Wider<_NType, std::enable_if_t<std::is_integral_v<_NType> && (sizeof(_NType) <= 8)>> {
+        using SignedType = std::conditional_t<sizeof(_NType) == 1, std::int16_t,
+                std::conditional_t<sizeof(_NType) == 2, std::int32_t,
+                        std::conditional_t<sizeof(_NType) == 4, std::int64_t, __int128>>>;
+
+        using type = std::conditional_t<std::is_signed_v<_NType>, SignedType, std::make_unsigned_t<SignedType>>;
+    };
+
+    template<class _NType>
+    using WiderType = typename Wider<_NType>::type;
+
+    template<class _NType, typename = void>
+    struct HasWider : std::false_type {
+    };
+
+    template<class _NType>
+    struct HasWider<_NType, std::void_t<WiderType<_NType>>> : std::true_type {
+    };
+
+    /**
+     * True for overflow checkers computing in _OverflowChecker::WideType
+     */
+    template<class _OverflowChecker, typename = void>
+    struct IsWidening : std::false_type {
+    };
+
+    template<class _OverflowChecker>
+    struct IsWidening<_OverflowChecker, std::void_t<typename _OverflowChecker::WideType>> : std::true_type {
+    };
+
+    /**
+     * True for overflow checkers recording telemetry: _OverflowChecker::OnGcd, OnLcm and
+     * OnSameDenominator are called by gcd, lcm and Fractional
+     */
+    template<class _OverflowChecker, typename = void>
+    struct IsInstrumented : std::false_type {
+    };
+
+    template<class _OverflowChecker>
+    struct IsInstrumented<_OverflowChecker, std::void_t<decltype(_OverflowChecker::OnGcd(std::size_t{}))>>
+            : std::true_type {
+    };
+
+    /**
+     * Number of trailing zero bits, value must not be zero
+     */
+    template<class _UType>
+    constexpr int CountTrailingZeros(const _UType &value) noexcept {
+        static_assert(std::is_unsigned_v<_UType>, "_UType must be unsigned");
+        if constexpr (sizeof(_UType) <= sizeof(unsigned)) {
+            return __builtin_ctz(static_cast<unsigned>(value));
+        } else if constexpr (sizeof(_UType) <= sizeof(unsigned long)) {
+            return __builtin_ctzl(static_cast<unsigned long>(value));
+        } else if constexpr (sizeof(_UType) <= sizeof(unsigned long long)) {
+            return __builtin_ctzll(static_cast<unsigned long long>(value));
+        } else {
+            auto low = static_cast<unsigned long long>(value);
+            return low != 0 ? __builtin_ctzll(low)
+                            : 64 + __builtin_ctzll(static_cast<unsigned long long>(value >> 64u));
+        }
+    }
+
+    /**
+     * Number of significant bits, zero for zero
+     */
+    template<class _UType>
+    constexpr std::size_t BitWidth(const _UType &value) noexcept {
+        static_assert(std::is_unsigned_v<_UType>, "_UType must be unsigned");
+        if (value == 0)
+            return 0;
+        if constexpr (sizeof(_UType) <= sizeof(unsigned long long)) {
+            return std::size_t(64 - __builtin_clzll(static_cast<unsigned long long>(value)));
+        } else {
+            auto high = static_cast<unsigned long long>(value >> 64u);
+            return high != 0 ? std::size_t(128 - __builtin_clzll(high))
+                             : BitWidth(static_cast<unsigned long long>(value));
+        }
+    }
+
+    enum class GcdEngine {
+        Binary,
+        Lehmer,
+        Euclid
+    };
+
+    /**
+     * Binary for built-in integers up to 64 bits,
+     * Lehmer for wider or unbounded integers,
+     * Euclid for every other _NType
+     */
+    template<class _NType>
+    constexpr GcdEngine SelectGcdEngine() noexcept {
+        using limits = std::numeric_limits<_NType>;
+        if constexpr (!limits::is_specialized || !limits::is_integer) {
+            return GcdEngine::Euclid;
+        } else if constexpr (limits::is_bounded && std::is_integral_v<_NType> && limits::digits <= 64) {
+            return GcdEngine::Binary;
+        } else if constexpr (!limits::is_bounded || std::is_integral_v<_NType>) {
+            return GcdEngine::Lehmer;
+        } else {
+            return GcdEngine::Euclid;
+        }
+    }
+
+    /**
+     * Stein's binary gcd of two unsigned values.
+     * Counters of the gcd engines are nullptr or point to a count of loop passes to increment.
+     */
+    template<class _UType, class _Counter = std::nullptr_t>
+    constexpr _UType BinaryGcd(_UType lhs, _UType rhs, _Counter iterations = nullptr) noexcept {
+        if (lhs == 0)
+            return rhs;
+        if (rhs == 0)
+            return lhs;
+
+        auto shift = CountTrailingZeros(_UType(lhs | rhs));
+        lhs >>= CountTrailingZeros(lhs);
+        do {
+            if constexpr (!std::is_null_pointer_v<_Counter>) {
+                ++*iterations;
+            }
+            rhs >>= CountTrailingZeros(rhs);
+            if (lhs > rhs) {
+                auto temp = lhs;
+                lhs = rhs;
+                rhs = temp;
+            }
+            rhs -= lhs;
+        } while (rhs != 0);
+        return _UType(lhs << shift);
+    }
+
+    /**
+     * Lehmer's gcd of two non-negative values wider than a machine word.
+     * Quotients are computed from the leading 63 bits while they agree with the
+     * true ones, the collected cofactors are applied to the full values at once.
+     * Finishes with BinaryGcd as soon as both values fit in 64 bits.
+     */
+    template<class _UType, class _Counter = std::nullptr_t>
+    constexpr _UType LehmerGcd(_UType lhs, _UType rhs, _Counter iterations = nullptr) {
+        using Word = unsigned long long;
+        using Cofactor = __int128;
+
+        if (lhs < rhs) {
+            auto temp = lhs;
+            lhs = rhs;
+            rhs = temp;
+        }
+
+        while (BitWidth(rhs) > 64) {
+            if constexpr (!std::is_null_pointer_v<_Counter>) {
+                ++*iterations;
+            }
+            auto shift = BitWidth(lhs) - 63;
+            Cofactor x = static_cast<Word>(lhs >> shift);
+            Cofactor y = static_cast<Word>(rhs >> shift);
+            Cofactor a = 1, b = 0, c = 0, d = 1;
+
+            while (y + c != 0 && y + d != 0) {
+                auto q = (x + a) / (y + c);
+                if (q != (x + b) / (y + d))
+                    break;
+                auto t = a - q * c;
+                a = c;
+                c = t;
+                t = b - q * d;
+                b = d;
+                d = t;
+                t = x - q * y;
+                x = y;
+                y = t;
+            }
+
+            if (b == 0) {
+                auto temp = lhs % rhs;
+                lhs = rhs;
+                rhs = temp;
+                continue;
+            }
+
+    /*
+     * a, b and c, d have opposite signs, both combinations are non-negative
+     */
+            auto combine = [](Cofactor p, const _UType &u, Cofactor q, const _UType &v) {
+                return q <= 0 ? _UType(static_cast<Word>(p)) * u - _UType(static_cast<Word>(-q)) * v
+                              : _UType(static_cast<Word>(q)) * v - _UType(static_cast<Word>(-p)) * u;
+            };
+            auto next_lhs = combine(a, lhs, b, rhs);
+            rhs = combine(c, lhs, d, rhs);
+            lhs = next_lhs;
+        }
+
+        if (rhs == _UType{})
+            return lhs;
+        lhs = lhs % rhs;
+        return _UType(BinaryGcd(static_cast<Word>(lhs), static_cast<Word>(rhs), iterations));
+    }
+
+    /**
+     * Iterative Euclid through _OverflowChecker operators, used for custom _NType.
+     * Operands are made non-negative once, modulus of non-negative values cannot overflow.
+     */
+    template<class _NType, class _OverflowChecker, class _Counter = std::nullptr_t>
+    constexpr _NType EuclidGcd(_NType lhs, _NType rhs, _Counter iterations = nullptr) {
         using Modulo = typename _OverflowChecker::ModulusOperator;
         using Negate = typename _OverflowChecker::NegateOperator;
         using Equals = typename _OverflowChecker::EqualOperator;
+        using Less = typename _OverflowChecker::LessOperator;
 
-        _OverflowChecker::CheckNegate(rhs);
-        if (Equals{}(Negate{}(rhs), rhs)) {
-            return lhs;
+        if (Less{}(lhs, _NType{})) {
+            _OverflowChecker::CheckNegate(lhs);
+            lhs = Negate{}(lhs);
+        }
+        if (Less{}(rhs, _NType{})) {
+            _OverflowChecker::CheckNegate(rhs);
+            rhs = Negate{}(rhs);
+        }
+
+        while (!Equals{}(rhs, _NType{})) {
+            if constexpr (!std::is_null_pointer_v<_Counter>) {
+                ++*iterations;
+            }
+            auto temp = Modulo{}(lhs, rhs);
+            lhs = rhs;
+            rhs = temp;
+        }
+        return lhs;
+    }
+
+    /**
+     * gcd incrementing *iterations by the loop passes of the engine, iterations may be nullptr
+     */
+    template<class _NType, class _OverflowChecker, class _Counter>
+    constexpr _NType CountingGcd(const _NType &lhs, const _NType &rhs, _Counter iterations) noexcept(
+    SelectGcdEngine<_NType>() == GcdEngine::Binary &&
+    noexcept(_OverflowChecker::CheckNegate(declval<_NType>()))
+    ) {
+        constexpr auto engine = SelectGcdEngine<_NType>();
+        if constexpr (engine == GcdEngine::Euclid) {
+            return EuclidGcd<_NType, _OverflowChecker>(lhs, rhs, iterations);
+        } else if constexpr (std::is_integral_v<_NType>) {
+            using UType = std::make_unsigned_t<_NType>;
+
+            auto magnitude = [](const _NType &value) {
+                return value < 0 ? UType(UType{} - UType(value)) : UType(value);
+            };
+            UType result{};
+            if constexpr (engine == GcdEngine::Binary) {
+                result = BinaryGcd(magnitude(lhs), magnitude(rhs), iterations);
+            } else {
+                result = LehmerGcd(magnitude(lhs), magnitude(rhs), iterations);
+            }
+            if (result > UType(std::numeric_limits<_NType>::max())) {
+    /*
+     * Only gcd(min, min) and gcd(min, 0) land here, the result is -min
+     */
+                _OverflowChecker::CheckNegate(std::numeric_limits<_NType>::lowest());
+            }
+            return _NType(result);
+        } else {
+            using Negate = typename _OverflowChecker::NegateOperator;
+            using Less = typename _OverflowChecker::LessOperator;
+
+            auto magnitude = [](const _NType &value) {
+                return Less{}(value, _NType{}) ? Negate{}(value) : value;
+            };
+            return LehmerGcd(magnitude(lhs), magnitude(rhs), iterations);
+        }
+    }
+
+    /**
+     * @return non-negative greatest common divisor, engine is selected by SelectGcdEngine
+     */
+    template<class _NType, class _OverflowChecker>
+    constexpr _NType gcd(const _NType &lhs, const _NType &rhs) noexcept(
+    noexcept(CountingGcd<_NType, _OverflowChecker>(lhs, rhs, nullptr))
+    ) {
+        if constexpr (IsInstrumented<_OverflowChecker>::value) {
+            std::size_t iterations = 0;
+            auto result = CountingGcd<_NType, _OverflowChecker>(lhs, rhs, &iterations);
+            _OverflowChecker::OnGcd(iterations);
+            return result;
+        } else {
+            return CountingGcd<_NType, _OverflowChecker>(lhs, rhs, nullptr);
         }
-        _OverflowChecker::CheckModulus(lhs, rhs);
-        return gcd<_NType, _OverflowChecker>(rhs, Modulo{}(lhs, rhs));
     }
 
     template<class _NType, class _OverflowChecker>
@@ -52,14 +396,14 @@ namespace fractional::utility {
     noexcept(typename _OverflowChecker::MultiplyOperator{}(declval<_NType>(), declval<_NType>())) &&
     noexcept(gcd<_NType, _OverflowChecker>(lhs, rhs))
     ) {
-        using Multiply = typename _OverflowChecker::MultiplyOperator;
-        using Divide = typename _OverflowChecker::DivideOperator;
+        using Multiply = OperatorWrapper<typename _OverflowChecker::MultiplyOperator, _OverflowChecker::CheckMultiply>;
+        using Divide = OperatorWrapper<typename _OverflowChecker::DivideOperator, _OverflowChecker::CheckDivide>;
 
+        if constexpr (IsInstrumented<_OverflowChecker>::value) {
+            _OverflowChecker::OnLcm();
+        }
         auto _gcd = gcd<_NType, _OverflowChecker>(lhs, rhs);
-        _OverflowChecker::CheckDivide(lhs, _gcd);
-        auto temp = Divide{}(lhs, _gcd);
-        _OverflowChecker::CheckMultiply(temp, rhs);
-        return Multiply{}(temp, rhs);
+        return Multiply{}(Divide{}(lhs, _gcd), rhs);
     }
 }
 
@@ -3,9 +3,34 @@
 //
 
 #include <iostream>
+#include <cfenv>
 #include <charconv>
 #include <boost/test/minimal.hpp>
 #include "fractional.hpp"
+#include "biginteger.hpp"
+#include "fractionvector.hpp"
+#include "parallel.hpp"
+#include "charconv.hpp"
+#include "ratio.hpp"
+#include "matrix.hpp"
+#include "instrumentation.hpp"
+#include "serialization.hpp"
+#include "fixedfractional.hpp"
+#include "sorting.hpp"
+#include "blockcache.hpp"
+#include "accumulator.hpp"
+#include "rounding.hpp"
+#include "kernels.hpp"
+#include "atomicfractional.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <array>
+#include <list>
+#include <unordered_set>
+#include <random>
+#include <thread>
 
 #define EPS 1e-10L
 
@@ -112,10 +137,98 @@ void test_overflow_max() {
     TEST_INTEGRAL(test_overflow_max);
 }
 
+template<class T>
+void test_builtin_overflow() {
+    using Integral = fractional::overflow::IntegralCheckOverflow<T>;
+    using Builtin = fractional::overflow::BuiltinCheckOverflow<T>;
+    auto max = std::numeric_limits<T>::max();
+    auto min = std::numeric_limits<T>::lowest();
+    T values[] = {min, T(min + 1), T(min / 2), T(-1), 0, 1, 2, T(max / 2), T(max - 1), max};
+
+    for (auto lhs : values) {
+        for (auto rhs : values) {
+            BOOST_CHECK(Integral::CheckPlus(lhs, rhs) == Builtin::CheckPlus(lhs, rhs));
+            BOOST_CHECK(Integral::CheckMinus(lhs, rhs) == Builtin::CheckMinus(lhs, rhs));
+            BOOST_CHECK(Integral::CheckMultiply(lhs, rhs) == Builtin::CheckMultiply(lhs, rhs));
+            BOOST_CHECK(Integral::CheckDivide(lhs, rhs) == Builtin::CheckDivide(lhs, rhs));
+        }
+        BOOST_CHECK(Builtin::CheckIncrement(lhs) == (lhs != max));
+        BOOST_CHECK(Builtin::CheckDecrement(lhs) == (lhs != min));
+    }
+}
+
+void test_builtin_overflow() {
+    TEST_INTEGRAL(test_builtin_overflow);
+
+    using fraction = fractional::Fractional<int, fractional::overflow::BuiltinThrowOnCheck>;
+    BOOST_CHECK(fraction(1, 2) + fraction(1, 3) == fraction(5, 6));
+    BOOST_CHECK(fraction(2, 3) * fraction(9, 4) == fraction(3, 2));
+
+    bool overflowed = false;
+    try {
+        fraction(std::numeric_limits<int>::max(), 1) + fraction(1, 1);
+    } catch (fraction::Checker::BinaryError const &error) {
+        overflowed = error.lhs() == std::numeric_limits<int>::max() && error.rhs() == 1;
+    }
+    BOOST_CHECK(overflowed);
+}
+
 bool is_equal(long double a, long double b) {
     return std::abs(a - b) < EPS;
 }
 
+template<class T, class Checker = fractional::overflow::ThrowOnCheck<T>>
+T gcd_of(T lhs, T rhs) {
+    return fractional::utility::gcd<T, Checker>(lhs, rhs);
+}
+
+template<class T>
+void test_gcd() {
+    BOOST_CHECK(gcd_of<T>(12, 18) == 6);
+    BOOST_CHECK(gcd_of<T>(18, 12) == 6);
+    BOOST_CHECK(gcd_of<T>(0, 7) == 7);
+    BOOST_CHECK(gcd_of<T>(7, 0) == 7);
+    BOOST_CHECK(gcd_of<T>(0, 0) == 0);
+    BOOST_CHECK(gcd_of<T>(64, 48) == 16);
+    BOOST_CHECK(gcd_of<T>(17, 5) == 1);
+    if constexpr (std::is_signed_v<T>) {
+        BOOST_CHECK(gcd_of<T>(-12, 18) == 6);
+        BOOST_CHECK(gcd_of<T>(12, -18) == 6);
+        BOOST_CHECK(gcd_of<T>(-12, -18) == 6);
+    }
+}
+
+void test_gcd() {
+    TEST_INTEGRAL(test_gcd);
+
+    using wide = __int128;
+    using WideChecker = fractional::overflow::NoCheck<wide>;
+
+/*
+ * Consecutive Fibonacci numbers are the worst case for Euclid
+ */
+    unsigned __int128 previous = 1, current = 1;
+    std::uint64_t previous64 = 1, current64 = 1;
+    for (int i = 0; i < 180; ++i) {
+        auto next = previous + current;
+        previous = current;
+        current = next;
+        if (i < 90) {
+            auto next64 = previous64 + current64;
+            previous64 = current64;
+            current64 = next64;
+        }
+    }
+    BOOST_CHECK((gcd_of<wide, WideChecker>(wide(current), wide(previous)) == 1));
+    BOOST_CHECK(gcd_of(current64, previous64) == 1);
+
+    wide factor = (wide(1) << 70) + 12345;
+    wide lhs = factor * 1000003, rhs = factor * 999983;
+    BOOST_CHECK((gcd_of<wide, WideChecker>(lhs, rhs) == factor));
+    BOOST_CHECK((gcd_of<wide, WideChecker>(-lhs, rhs) == factor));
+    BOOST_CHECK(gcd_of(std::uint64_t(1) << 63, std::uint64_t(3) << 40) == std::uint64_t(1) << 40);
+}
+
 template<class fraction>
 void test_fraction() {
     try {
@@ -126,6 +239,1389 @@ void test_fraction() {
 //    t = t + t;
 }
 
+template<class fraction>
+void test_fraction_arithmetic() {
+    fraction half{1, 2};
+    fraction third{1, 3};
+    fraction quarter{1, 4};
+
+    BOOST_CHECK(half + third == fraction(5, 6));
+    BOOST_CHECK(half - third == fraction(1, 6));
+    BOOST_CHECK(third - half == fraction(-1, 6));
+    BOOST_CHECK(half * third == fraction(1, 6));
+    BOOST_CHECK(half / third == fraction(3, 2));
+    BOOST_CHECK(-half == fraction(-1, 2));
+    BOOST_CHECK(fraction(2, 4) == half);
+    BOOST_CHECK(fraction(-1, -2) == half);
+    BOOST_CHECK(fraction(1, -2) == -half);
+
+    auto product = fraction{6, 35} * fraction{14, 9};
+    BOOST_CHECK(product.nominator() == 4 && product.denominator() == 15);
+
+    auto value = half;
+    value += quarter;
+    BOOST_CHECK(value == fraction(3, 4));
+    value -= half;
+    BOOST_CHECK(value == quarter);
+    value *= fraction{8, 3};
+    BOOST_CHECK(value == fraction(2, 3));
+    value /= fraction{4, 9};
+    BOOST_CHECK(value == fraction(3, 2));
+    value += value;
+    BOOST_CHECK(value == fraction(3, 1));
+
+    BOOST_CHECK(third < half);
+    BOOST_CHECK(!(half < third));
+    BOOST_CHECK(-half < third);
+    BOOST_CHECK(fraction(7, 3) > fraction(9, 4));
+    BOOST_CHECK(fraction(-7, 3) < fraction(-9, 4));
+    BOOST_CHECK(fraction(5, -3) < fraction(-3, 2));
+    BOOST_CHECK(fraction(2, 3) <= fraction(4, 6));
+    BOOST_CHECK(fraction(2, 3) >= fraction(4, 6));
+    BOOST_CHECK(fraction(0, 5) == fraction(0, -3));
+    BOOST_CHECK(fraction(3, 7) != fraction(3, 8));
+    BOOST_CHECK(Compare(fraction(10, 4), fraction(5, 2)) == 0);
+}
+
+template<class fraction>
+fraction telescoping_sum(int terms) {
+    fraction sum{0, 1};
+    for (int k = 1; k <= terms; ++k) {
+        sum += fraction{1, k * (k + 1)};
+    }
+    return sum;
+}
+
+void test_normalization() {
+    using namespace fractional;
+    using eager = Fractional<int, overflow::ThrowOnCheck, overflow::IntegralCheckOverflow, normalization::Eager>;
+    using lazy = Fractional<int, overflow::ThrowOnCheck, overflow::IntegralCheckOverflow, normalization::Lazy<>>;
+    using none = Fractional<int, overflow::ThrowOnCheck, overflow::IntegralCheckOverflow, normalization::None>;
+
+    eager canonical{6, -8};
+    BOOST_CHECK(canonical.nominator() == -3 && canonical.denominator() == 4);
+    auto zero = eager{0, -7};
+    BOOST_CHECK(zero.nominator() == 0 && zero.denominator() == 1);
+
+    auto sum = telescoping_sum<eager>(1000);
+    BOOST_CHECK(sum.nominator() == 1000 && sum.denominator() == 1001);
+
+    auto lazy_sum = telescoping_sum<lazy>(1000);
+    BOOST_CHECK(lazy_sum == lazy(1000, 1001));
+    BOOST_CHECK(lazy_sum.reduce().nominator() == 1000 && lazy_sum.denominator() == 1001);
+
+    none raw{2, 4};
+    BOOST_CHECK(raw.nominator() == 2 && raw.denominator() == 4);
+    BOOST_CHECK(raw == none(1, 2));
+
+    bool overflowed = false;
+    try {
+        telescoping_sum<none>(1000);
+    } catch (none::Checker::BinaryError const &) {
+        overflowed = true;
+    }
+    BOOST_CHECK(overflowed);
+}
+
+void test_widening() {
+    using namespace fractional;
+    using wide = Fractional<std::int64_t, overflow::WideningThrowOnCheck>;
+    using narrow = Fractional<std::int64_t>;
+    const std::int64_t lhs_n = 3 * (std::int64_t(1) << 60) + 1;
+    const std::int64_t rhs_n = -5 * (std::int64_t(1) << 60) + 2;
+
+    bool overflowed = false;
+    try {
+        narrow(lhs_n, 3) + narrow(rhs_n, 5);
+    } catch (narrow::Checker::BinaryError const &) {
+        overflowed = true;
+    }
+    BOOST_CHECK(overflowed);
+
+    auto sum = wide(lhs_n, 3) + wide(rhs_n, 5);
+    BOOST_CHECK(sum.nominator() == 11 && sum.denominator() == 15);
+    BOOST_CHECK(wide(lhs_n, 3) - wide(-rhs_n, 5) == wide(11, 15));
+    BOOST_CHECK(wide(lhs_n, 7) * wide(14, lhs_n) == wide(2, 1));
+    BOOST_CHECK(wide(lhs_n, 7) / wide(lhs_n, 14) == wide(2, 1));
+    BOOST_CHECK(wide(6, -4) == wide(-3, 2));
+
+    using wide32 = Fractional<std::uint32_t, overflow::WideningThrowOnCheck>;
+    BOOST_CHECK(wide32(1, 6) + wide32(1, 3) == wide32(1, 2));
+
+    overflowed = false;
+    try {
+        wide(std::numeric_limits<std::int64_t>::max(), 1) + wide(1, 1);
+    } catch (wide::Checker::NarrowError const &) {
+        overflowed = true;
+    }
+    BOOST_CHECK(overflowed);
+
+    overflowed = false;
+    try {
+        wide32(1, 2) - wide32(2, 3);
+    } catch (wide32::Checker::WideError const &) {
+        overflowed = true;
+    }
+    BOOST_CHECK(overflowed);
+}
+
+void test_big_integer() {
+    using fractional::BigInteger;
+    using fractional::big_fraction;
+    auto max = std::numeric_limits<std::int64_t>::max();
+
+    BigInteger small{42};
+    BOOST_CHECK(small.is_inline());
+    BigInteger promoted = BigInteger{max} + 1;
+    BOOST_CHECK(!promoted.is_inline());
+    BOOST_CHECK(to_string(promoted) == "9223372036854775808");
+    BigInteger demoted = promoted - 1;
+    BOOST_CHECK(demoted.is_inline() && demoted == max);
+    BOOST_CHECK((-promoted).is_inline());
+    BOOST_CHECK(BigInteger{std::numeric_limits<std::uint64_t>::max()} == promoted * 2 - 1);
+
+    BigInteger factorial = 1;
+    for (int i = 1; i <= 30; ++i) {
+        factorial *= i;
+    }
+    BOOST_CHECK(to_string(factorial) == "265252859812191058636308480000000");
+    BOOST_CHECK(to_string(-factorial / 1000000007) == "-265252857955421052948361");
+    BOOST_CHECK(factorial % 1000000007 == 109361473);
+    BOOST_CHECK(factorial / factorial == 1);
+    BOOST_CHECK(-factorial < factorial && factorial > max);
+    BOOST_CHECK((factorial >> 64) == BigInteger{14379386343318});
+    BOOST_CHECK(((factorial >> 64) << 64) + (factorial - ((factorial >> 64) << 64)) == factorial);
+
+    BigInteger lhs = factorial * 1000003, rhs = factorial * 999983;
+    BOOST_CHECK((fractional::utility::gcd<BigInteger, fractional::overflow::NoCheck<BigInteger>>(lhs, rhs) ==
+                 factorial));
+
+    big_fraction sum{0, 1};
+    for (int k = 1; k <= 40; ++k) {
+        sum += big_fraction{1, BigInteger(k) * BigInteger(k)};
+    }
+    BOOST_CHECK(!sum.denominator().is_inline());
+    for (int k = 1; k <= 40; ++k) {
+        sum -= big_fraction{1, BigInteger(k) * BigInteger(k)};
+    }
+    BOOST_CHECK(sum == big_fraction(0, 1) && sum.denominator() == 1);
+
+    auto product = big_fraction{factorial, 7} * big_fraction{14, factorial};
+    BOOST_CHECK(product.nominator() == 2 && product.denominator() == 1);
+}
+
+template<class T>
+bool vector_lane(fractional::simd::Operation op, T a, T b, T c, T d, T &n, T &den) {
+    using fractional::simd::Operation;
+    __int128 first = 0, second = 0, wn = 0, wden = 0;
+    bool overflow = false;
+    auto product = [&](T lhs, T rhs, __int128 &result) {
+        overflow |= __builtin_mul_overflow(__int128(lhs), __int128(rhs), &result);
+    /*
+     * 64-bit lanes have no wider type, every intermediate product must fit
+     */
+        overflow |= sizeof(T) == 8 && __int128(T(result)) != result;
+    };
+    switch (op) {
+        case Operation::Add:
+        case Operation::Subtract:
+            product(a, d, first), product(c, b, second), product(b, d, wden);
+            overflow |= op == Operation::Add ? __builtin_add_overflow(first, second, &wn)
+                                             : __builtin_sub_overflow(first, second, &wn);
+            break;
+        case Operation::Multiply:
+            product(a, c, wn), product(b, d, wden);
+            break;
+        case Operation::Divide:
+            product(a, d, wn), product(b, c, wden);
+            if (wden < 0)
+                wn = -wn, wden = -wden;
+            break;
+    }
+    n = T(wn), den = T(wden);
+    return overflow || wden == 0 || __int128(n) != wn || __int128(den) != wden;
+}
+
+template<class T>
+void test_fraction_vector() {
+    using namespace fractional;
+    using simd::Operation;
+    std::vector<T> samples{T(0), T(1), T(2), T(3), T(7), T(12), T(100),
+                           std::numeric_limits<T>::max(), T(std::numeric_limits<T>::max() / 2),
+                           T(std::numeric_limits<T>::max() / 3)};
+    if constexpr (std::is_signed_v<T>) {
+        samples.insert(samples.end(), {T(-1), T(-5), std::numeric_limits<T>::lowest(), T(-100)});
+    }
+
+    FractionVector<T> lhs, rhs;
+    for (auto a : samples)
+        for (auto b : samples)
+            for (auto c : samples)
+                for (auto d : samples)
+                    if (b != 0 && d != 0) {
+                        lhs.push_back(a, b);
+                        rhs.push_back(c, d);
+                    }
+
+    auto check = [&](Operation op, const FractionVector<T> &out, const OverflowMask &mask, std::size_t count,
+                     bool broadcast) {
+        bool ok = mask.size() == lhs.size() && out.size() == lhs.size();
+        std::size_t overflows = 0;
+        for (std::size_t i = 0; ok && i < lhs.size(); ++i) {
+            std::size_t j = broadcast ? 0 : i;
+            T n{}, den{};
+            bool overflow = vector_lane(op, lhs.nominators()[i], lhs.denominators()[i],
+                                        rhs.nominators()[j], rhs.denominators()[j], n, den);
+            overflows += overflow;
+            ok = mask[i] == overflow && (overflow || (out.nominators()[i] == n && out.denominators()[i] == den));
+        }
+        return ok && overflows == count;
+    };
+
+    FractionVector<T> out;
+    OverflowMask mask;
+    BOOST_CHECK(check(Operation::Add, out, mask, add(lhs, rhs, out, mask), false));
+    BOOST_CHECK(check(Operation::Subtract, out, mask, sub(lhs, rhs, out, mask), false));
+    BOOST_CHECK(check(Operation::Multiply, out, mask, mul(lhs, rhs, out, mask), false));
+    BOOST_CHECK(check(Operation::Divide, out, mask, div(lhs, rhs, out, mask), false));
+
+    using fract = Fractional<T, overflow::NoCheck, overflow::IntegralCheckOverflow, normalization::None>;
+    fract scalar{rhs.nominators()[0], rhs.denominators()[0]};
+    BOOST_CHECK(check(Operation::Add, out, mask, add(lhs, scalar, out, mask), true));
+    BOOST_CHECK(check(Operation::Divide, out, mask, div(lhs, scalar, out, mask), true));
+
+    FractionVector<T> same, other;
+    for (auto a : samples) {
+        for (auto c : samples) {
+            same.push_back(a, T(12));
+            other.push_back(c, T(12));
+        }
+    }
+    auto overflows = add(same, other, out, mask);
+    bool plain = true;
+    std::size_t expected = 0;
+    for (std::size_t i = 0; i < same.size(); ++i) {
+        T n{};
+        bool overflow = __builtin_add_overflow(same.nominators()[i], other.nominators()[i], &n);
+        expected += overflow;
+        plain &= mask[i] == overflow && (overflow || (out.nominators()[i] == n && out.denominators()[i] == 12));
+    }
+    BOOST_CHECK(plain && overflows == expected);
+
+    FractionVector<T> halves(3);
+    halves.set(1, fract{1, 2});
+    halves.set(2, fract{3, 4});
+    add(halves, fract{1, 4}, halves, mask);
+    halves.template reduce<fract>();
+    BOOST_CHECK(halves.nominators()[0] == 1 && halves.denominators()[0] == 4);
+    BOOST_CHECK(halves.nominators()[1] == 3 && halves.denominators()[1] == 4);
+    BOOST_CHECK(halves.nominators()[2] == 1 && halves.denominators()[2] == 1);
+    BOOST_CHECK(reinterpret_cast<std::uintptr_t>(halves.nominators()) % 64 == 0);
+}
+
+void test_parallel_reduce() {
+    using namespace fractional;
+    using lazy = Fractional<BigInteger, overflow::NoCheck, overflow::IntegralCheckOverflow, normalization::Lazy<>>;
+
+    std::vector<big_fraction> values;
+    std::vector<lazy> lazy_values;
+    for (int k = 1; k <= 300; ++k) {
+        values.emplace_back(k % 7 == 0 ? -1 : 1, BigInteger(k) * (k + 1));
+        lazy_values.emplace_back(k % 7 == 0 ? -1 : 1, BigInteger(k) * (k + 1));
+    }
+    auto serial = values.front();
+    for (std::size_t i = 1; i < values.size(); ++i) {
+        serial += values[i];
+    }
+
+    ReduceOptions options{4, 7};
+    auto parallel = fractional::sum(values.begin(), values.end(), options);
+    BOOST_CHECK(parallel == serial);
+    BOOST_CHECK(parallel.nominator() == serial.nominator() && parallel.denominator() == serial.denominator());
+    BOOST_CHECK(fractional::sum(values.begin(), values.end(), ReduceOptions{1, 1}) == serial);
+
+    auto lazy_sum = fractional::sum(lazy_values.begin(), lazy_values.end(), options);
+    BOOST_CHECK(lazy_sum.nominator() == serial.nominator() && lazy_sum.denominator() == serial.denominator());
+
+    std::list<big_fraction> list(values.begin(), values.end());
+    BOOST_CHECK(fractional::sum(list.begin(), list.end(), options) == serial);
+    BOOST_CHECK(fractional::reduce(list.begin(), list.end(), big_fraction{1, 2}, std::plus<>{}, options) ==
+                serial + big_fraction(1, 2));
+
+    std::vector<big_fraction> factors;
+    for (int k = 1; k <= 100; ++k) {
+        factors.emplace_back(k + 1, k);
+    }
+    BOOST_CHECK(fractional::product(factors.begin(), factors.end(), options) == big_fraction(101, 1));
+    BOOST_CHECK(fractional::product(factors.begin(), factors.begin(), options) == big_fraction(1, 1));
+
+    std::vector<fraction> lhs, rhs;
+    for (int k = 1; k <= 50; ++k) {
+        lhs.emplace_back(k, k + 1);
+        rhs.emplace_back(k + 1, k);
+    }
+    BOOST_CHECK(fractional::dot(lhs.begin(), lhs.end(), rhs.begin(), options) == fraction(50, 1));
+    BOOST_CHECK(fractional::sum(lhs.begin(), lhs.begin(), options) == fraction(0, 1));
+
+    std::vector<fraction> large(64, fraction{std::numeric_limits<int>::max(), 1});
+    bool overflowed = false;
+    try {
+        fractional::sum(large.begin(), large.end(), options);
+    } catch (fraction::Checker::BinaryError const &) {
+        overflowed = true;
+    }
+    BOOST_CHECK(overflowed);
+}
+
+void test_flag_on_check() {
+    using namespace fractional;
+    using overflow::OverflowFlags;
+    using overflow::OverflowStatus;
+    using flagged = Fractional<int, overflow::FlagOnCheck>;
+    const int max = std::numeric_limits<int>::max();
+
+    static_assert(flagged::IsNothrow, "FlagOnCheck arithmetic must be noexcept");
+    static_assert(noexcept(flagged(1, 2) + flagged(1, 3)), "Plus must be noexcept");
+    static_assert(noexcept(flagged(1, 2) - flagged(1, 3)), "Minus must be noexcept");
+    static_assert(!fraction::IsNothrow, "ThrowOnCheck arithmetic throws");
+
+    OverflowStatus::Clear();
+    auto sum = flagged(1, 6) + flagged(1, 3);
+    BOOST_CHECK(sum == flagged(1, 2) && OverflowStatus::Test() == OverflowFlags::None);
+
+    flagged(max, 1) + flagged(1, 1);
+    BOOST_CHECK(OverflowStatus::Test(OverflowFlags::Plus));
+    flagged(1, 2) * flagged(3, 4);
+    BOOST_CHECK(OverflowStatus::Test(OverflowFlags::Plus));
+    OverflowStatus::Clear(OverflowFlags::Plus);
+    BOOST_CHECK(OverflowStatus::Test() == OverflowFlags::None);
+
+    flagged(max, 2) * flagged(max, 3);
+    BOOST_CHECK(OverflowStatus::Test() == OverflowFlags::Multiply);
+    OverflowStatus::Clear();
+
+    flagged(1, 0);
+    BOOST_CHECK(OverflowStatus::Test() == OverflowFlags::Divide);
+    OverflowStatus::Clear();
+
+    auto ok = try_add(fraction(1, 6), fraction(1, 3));
+    BOOST_CHECK(ok && *ok == fraction(1, 2) && ok.error() == OverflowFlags::None);
+    auto failed = try_add(fraction(max, 1), fraction(1, 1));
+    BOOST_CHECK(!failed && failed.error() == OverflowFlags::Plus);
+    BOOST_CHECK(failed.value_or(fraction(0, 1)) == fraction(0, 1));
+    BOOST_CHECK(!try_sub(fraction(-max, 1), fraction(2, 1)));
+    BOOST_CHECK(*try_sub(fraction(1, 2), fraction(1, 3)) == fraction(1, 6));
+    BOOST_CHECK(try_mul(fraction(max, 2), fraction(max, 3)).error() == OverflowFlags::Multiply);
+    BOOST_CHECK(try_mul(fraction(max, 2), fraction(2, max))->nominator() == 1);
+
+    OverflowStatus::Raise(OverflowFlags::Negate);
+    BOOST_CHECK(!try_add(flagged(max, 1), flagged(max, 1)));
+    BOOST_CHECK(OverflowStatus::Test() == OverflowFlags::Negate);
+    OverflowStatus::Clear();
+}
+
+void test_charconv() {
+    using namespace fractional;
+    auto parse = [](std::string_view text, auto &value) {
+        return fractional::from_chars(text.data(), text.data() + text.size(), value);
+    };
+    fraction value{0, 1};
+
+    BOOST_CHECK(parse("12.375", value).ec == std::errc{} && value == fraction(99, 8));
+    BOOST_CHECK(parse("-1 3/4", value).ec == std::errc{} && value == fraction(-7, 4));
+    BOOST_CHECK(parse("6/4", value).ec == std::errc{} && value == fraction(3, 2));
+    BOOST_CHECK(parse(".5", value).ec == std::errc{} && value == fraction(1, 2));
+    BOOST_CHECK(parse("-12.", value).ec == std::errc{} && value == fraction(-12, 1));
+    BOOST_CHECK(parse("0.50000000000000000000", value).ec == std::errc{} && value == fraction(1, 2));
+    BOOST_CHECK(parse("-2147483648", value).ec == std::errc{} && value.nominator() == std::numeric_limits<int>::min());
+
+    std::string_view text = "7 8";
+    auto result = parse(text, value);
+    BOOST_CHECK(result.ptr == text.data() + 1 && value == fraction(7, 1));
+    text = "1/0";
+    result = parse(text, value);
+    BOOST_CHECK(result.ec == std::errc::invalid_argument && result.ptr == text.data());
+    BOOST_CHECK(parse("-", value).ec == std::errc::invalid_argument);
+    BOOST_CHECK(parse(".", value).ec == std::errc::invalid_argument);
+    text = "2147483648/3 ";
+    result = parse(text, value);
+    BOOST_CHECK(result.ec == std::errc::result_out_of_range && result.ptr == text.data() + 12);
+    BOOST_CHECK(parse("0.0000000001", value).ec == std::errc::result_out_of_range);
+    BOOST_CHECK(parse("0.0000000005", value).ec == std::errc{} && value == fraction(1, 2000000000));
+    BOOST_CHECK(parse("-1073741823.5", value).ec == std::errc{} && value == fraction(-2147483647, 2));
+    Fractional<std::int64_t> wide{0, 1};
+    BOOST_CHECK(parse("0.0000000000000000005", wide).ec == std::errc{} &&
+                wide == Fractional<std::int64_t>(1, 2000000000000000000));
+    Fractional<unsigned> positive{0, 1};
+    BOOST_CHECK(parse("-1/2", positive).ec == std::errc::invalid_argument);
+
+    char buffer[24];
+    auto written = fractional::to_chars(buffer, buffer + sizeof(buffer), fraction(-99, 8));
+    BOOST_CHECK(written.ec == std::errc{} && std::string_view(buffer, written.ptr - buffer) == "-99/8");
+    BOOST_CHECK(fractional::to_chars(buffer, buffer + 4, fraction(-99, 8)).ec == std::errc::value_too_large);
+    BOOST_CHECK(fractional::to_chars(buffer, buffer + 3, fraction(-99, 8)).ec == std::errc::value_too_large);
+    for (auto fract : {fraction(0, 1), fraction(-7, 3), fraction(std::numeric_limits<int>::min(), 1)}) {
+        written = fractional::to_chars(buffer, buffer + sizeof(buffer), fract);
+        BOOST_CHECK(parse(std::string_view(buffer, written.ptr - buffer), value).ec == std::errc{} && value == fract);
+    }
+
+    std::vector<fraction> values;
+    auto parsed = parse_fractions("  1/2, 3.25;-1 1/2\n7\r\n", values);
+    BOOST_CHECK(parsed.ec == std::errc{} && parsed.count == 4 && values.size() == 4);
+    BOOST_CHECK(values[0] == fraction(1, 2) && values[1] == fraction(13, 4));
+    BOOST_CHECK(values[2] == fraction(-3, 2) && values[3] == fraction(7, 1));
+    parsed = parse_fractions("1/3 2x", values);
+    BOOST_CHECK(parsed.ec == std::errc::invalid_argument && parsed.count == 1 && values.size() == 5);
+    BOOST_CHECK(*parsed.ptr == 'x');
+
+    fraction fixed[2] = {{0, 1}, {0, 1}};
+    text = "1 2 3";
+    parsed = parse_fractions(text, fixed, 2);
+    BOOST_CHECK(parsed.ec == std::errc::value_too_large && parsed.count == 2 && parsed.ptr == text.data() + 4);
+    BOOST_CHECK(fixed[0] == fraction(1, 1) && fixed[1] == fraction(2, 1));
+}
+
+void test_approximate() {
+    using namespace fractional;
+    const int max = std::numeric_limits<int>::max();
+    const double pi = 3.14159265358979323846;
+
+    BOOST_CHECK(fraction::approximate(pi, 1000) == fraction(355, 113));
+    BOOST_CHECK(fraction::approximate(pi, 100) == fraction(311, 99));
+    BOOST_CHECK(fraction::approximate(-pi, 7) == fraction(-22, 7));
+    BOOST_CHECK(fraction::approximate(0.1, 10) == fraction(1, 10));
+    BOOST_CHECK(fraction::approximate(0.375, max) == fraction(3, 8));
+    BOOST_CHECK(fraction::approximate(-1234.5625, max) == fraction(-19753, 16));
+    BOOST_CHECK(fraction::approximate(0.0, 5) == fraction(0, 1));
+    BOOST_CHECK(fraction::approximate(1e-300, max) == fraction(0, 1));
+    BOOST_CHECK(fraction::approximate(1e20, 10) == fraction(max, 1));
+    BOOST_CHECK(fraction::approximate(-1e20, 10) == fraction(-max, 1));
+    BOOST_CHECK(fraction::approximate(max - 0.25, 10) == fraction(max, 1));
+    BOOST_CHECK(Fractional<unsigned>::approximate(-0.5, 10) == Fractional<unsigned>(0, 1));
+    BOOST_CHECK(Fractional<std::int64_t>::approximate(0x1p-60, std::int64_t(1) << 62) ==
+                Fractional<std::int64_t>(1, std::int64_t(1) << 60));
+
+    BOOST_CHECK(fraction::approximate_within(pi, 1e-2) == fraction(22, 7));
+    BOOST_CHECK(fraction::approximate_within(pi, 1e-3) == fraction(201, 64));
+    BOOST_CHECK(fraction::approximate_within(0.3333, 1e-3) == fraction(1, 3));
+    BOOST_CHECK(fraction::approximate_within(0.3333, 0.5) == fraction(0, 1));
+    BOOST_CHECK(fraction::approximate_within(pi, 0, 1000) == fraction(355, 113));
+    BOOST_CHECK(fraction::approximate_within(2.5, 0) == fraction(5, 2));
+
+    /*
+     * Against exhaustive search over every denominator
+     */
+    auto error = [](double x, long double p, long double q) {
+        return std::fabs((long double) x * q - p) / q;
+    };
+    std::uint64_t state = 88172645463325252ull;
+    for (int i = 0; i < 2000; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        auto x = double(state % 2000001) / 1000000.0 - 1.0;
+        int max_denominator = int(state >> 40) % 200 + 1;
+        double tolerance = 1e-5 * double(state >> 58);
+
+        long double best = 2;
+        int smallest = 0;
+        for (int q = 1; q <= max_denominator; ++q) {
+            auto p = std::round((long double) x * q);
+            best = std::min(best, error(x, p, q));
+            if (smallest == 0 && error(x, p, q) <= tolerance)
+                smallest = q;
+        }
+
+        auto closest = fraction::approximate(x, max_denominator);
+        BOOST_CHECK(closest.denominator() <= max_denominator);
+        BOOST_CHECK(std::fabs(error(x, closest.nominator(), closest.denominator()) - best) <= 1e-15L);
+
+        auto within = fraction::approximate_within(x, tolerance, max_denominator);
+        if (smallest != 0) {
+            BOOST_CHECK(within.denominator() == smallest);
+            BOOST_CHECK(error(x, within.nominator(), within.denominator()) <= tolerance);
+        } else {
+            BOOST_CHECK(within == closest);
+        }
+    }
+
+    double samples[] = {0.5, -0.75, pi};
+    fraction approximated[3] = {{0, 1}, {0, 1}, {0, 1}};
+    fractional::approximate(std::begin(samples), std::end(samples), approximated, 113);
+    BOOST_CHECK(approximated[0] == fraction(1, 2) && approximated[1] == fraction(-3, 4));
+    BOOST_CHECK(approximated[2] == fraction(355, 113));
+}
+
+void test_floating_conversion() {
+    using namespace fractional;
+    using int64 = Fractional<std::int64_t>;
+    using uint64 = Fractional<std::uint64_t>;
+    using int128 = Fractional<__int128, overflow::NoCheck>;
+    const std::int64_t max = std::numeric_limits<std::int64_t>::max();
+    const std::int64_t p53 = std::int64_t(1) << 53, p60 = std::int64_t(1) << 60, p62 = std::int64_t(1) << 62;
+
+    const fraction third{1, 3};
+    BOOST_CHECK(double(third) == 1.0 / 3);
+    BOOST_CHECK(float(fraction(-7, 3)) == -7.0f / 3);
+    static_assert(noexcept(double(third)), "conversion of built-in fractions must not throw");
+
+    int64 values[] = {{p53 + 1, 1}, {-(p53 + 1), 1}, {3 * p60 + 1, 3}, {max, max - 1}, {max, p62 + 1}};
+    int roundings[] = {FE_TONEAREST, FE_UPWARD, FE_DOWNWARD, FE_TOWARDZERO};
+    double expected[4][5] = {
+            {0x1p53, -0x1p53, 0x1p60, 1, 2},
+            {0x1p53 + 2, -0x1p53, 0x1p60 + 256, std::nextafter(1.0, 2.0), 2},
+            {0x1p53, -0x1p53 - 2, 0x1p60, 1, std::nextafter(2.0, 0.0)},
+            {0x1p53, -0x1p53, 0x1p60, 1, std::nextafter(2.0, 0.0)}};
+    for (int mode = 0; mode < 4; ++mode) {
+        std::fesetround(roundings[mode]);
+        for (int i = 0; i < 5; ++i) {
+            BOOST_CHECK(double(values[i]) == expected[mode][i]);
+        }
+    }
+    std::fesetround(FE_TONEAREST);
+
+    auto p100 = __int128(1) << 100;
+    BOOST_CHECK(double(int128(p100 + 1, p100 - 1)) == 1.0);
+    BOOST_CHECK(double(int128(-(p100 + 3), 3 * p100)) == -1.0 / 3);
+    BOOST_CHECK(float(int128(1, 3 * (__int128(1) << 125))) == float(std::ldexp(1.0 / 3, -125)));
+    BOOST_CHECK(float(int128(std::numeric_limits<__int128>::max(), 1)) == 0x1p127f);
+
+    auto umax = std::numeric_limits<std::uint64_t>::max();
+    BOOST_CHECK((long double) uint64(umax, 3) == 6148914691236517205.0L);
+    BOOST_CHECK((long double) uint64(umax, umax - 2) == std::nextafter(1.0L, 2.0L));
+    BOOST_CHECK(double(uint64(umax, 1)) == 0x1p64);
+
+    fraction small[] = {{1, 3}, {-5, 4}, {7, 1}};
+    double converted[3];
+    to_double(std::begin(small), std::end(small), converted);
+    BOOST_CHECK(converted[0] == 1.0 / 3 && converted[1] == -1.25 && converted[2] == 7);
+
+    double wide[5];
+    to_double(std::begin(values), std::end(values), wide);
+    for (int i = 0; i < 5; ++i) {
+        BOOST_CHECK(wide[i] == expected[0][i]);
+    }
+    uint64 unsigned_values[] = {{umax, 1}, {1, 4}};
+    to_double(std::begin(unsigned_values), std::end(unsigned_values), wide);
+    BOOST_CHECK(wide[0] == 0x1p64 && wide[1] == 0.25);
+}
+
+template<class _Ratio>
+struct RatioName {
+    static constexpr const char *value = "other";
+};
+
+template<>
+struct RatioName<fractional::Ratio<1, 2>> {
+    static constexpr const char *value = "half";
+};
+
+void test_constexpr() {
+    using namespace fractional;
+    using wide = Fractional<long long, overflow::BuiltinThrowOnCheck, overflow::BuiltinCheckOverflow>;
+    using lazy = Fractional<int, overflow::ThrowOnCheck, overflow::IntegralCheckOverflow, normalization::Lazy<>>;
+
+    constexpr fraction inch{254, 10000};
+    constexpr fraction feet_per_mile{5280, 1};
+    constexpr fraction table[] = {inch, inch * fraction(12, 1), inch * fraction(12, 1) * feet_per_mile};
+    static_assert(table[1] == fraction(381, 1250), "foot in meters");
+    static_assert(table[2].nominator() == 201168 && table[2].denominator() == 125, "mile in meters");
+    static_assert(table[2] / table[1] == feet_per_mile, "exact round trip");
+    static_assert(-fraction(1, 3) + fraction(1, 2) - fraction(1, 6) == fraction(0, 1), "plus and minus");
+    static_assert(fraction(2, 3) > fraction(3, 5) && fraction(-1, 2) < fraction(1, 3), "compare");
+    static_assert(wide(1, 3) * wide(3, 7) == wide(1, 7), "builtin checker");
+    static_assert(lazy(2, 4) + lazy(1, 4) == lazy(3, 4), "lazy normalization");
+    static_assert(double(fraction(1, 4)) == 0.25, "conversion");
+    static_assert([] {
+        fraction value{1, 2};
+        value += fraction(1, 3);
+        value *= fraction(6, 5);
+        return value;
+    }() == fraction(1, 1), "compound assignment");
+    BOOST_CHECK(double(table[2]) == 1609.344);
+
+    static_assert(std::is_same_v<Ratio<2, 4>, Ratio<1, 2>>, "ratios are reduced");
+    static_assert(std::is_same_v<Ratio<3, -6>, BasicRatio<-1, 2>>, "denominator is positive");
+    static_assert(std::is_same_v<RatioAdd<Ratio<1, 6>, Ratio<1, 3>>, Ratio<1, 2>>, "add");
+    static_assert(std::is_same_v<RatioSubtract<Ratio<1, 6>, Ratio<1, 3>>, Ratio<-1, 6>>, "subtract");
+    static_assert(std::is_same_v<RatioMultiply<Ratio<2, 3>, Ratio<9, 4>>, Ratio<3, 2>>, "multiply");
+    static_assert(std::is_same_v<RatioDivide<Ratio<2, 3>, Ratio<4, 9>>, Ratio<3, 2>>, "divide");
+    static_assert(std::is_same_v<RatioFromStd<std::milli>, Ratio<std::intmax_t(1), std::intmax_t(1000)>>, "std");
+    static_assert(RatioLess<Ratio<1, 3>, Ratio<1, 2>>::value, "less");
+    static_assert(Ratio<6, 4>::value() == fraction(3, 2), "value");
+    static_assert(Ratio<6, 4>::value<lazy>() == lazy(3, 2), "value of other policy");
+    constexpr fraction converted = Ratio<5, 10>{};
+    static_assert(converted == fraction(1, 2), "conversion to Fractional");
+    BOOST_CHECK(std::string(RatioName<Ratio<3, 6>>::value) == "half");
+    BOOST_CHECK(std::string(RatioName<Ratio<1, 3>>::value) == "other");
+}
+
+void test_matrix() {
+    using namespace fractional;
+    using ll = Fractional<long long>;
+
+    Matrix<ll> small{{ll(2, 1), ll(1, 2)}, {ll(1, 3), ll(1, 1)}};
+    BOOST_CHECK(determinant(small) == ll(11, 6));
+    BOOST_CHECK(rank(small) == 2);
+
+    Matrix<ll> swapped{{ll(0, 1), ll(1, 1), ll(2, 1)}, {ll(1, 1), ll(0, 1), ll(3, 1)}, {ll(4, 1), ll(-3, 1), ll(8, 1)}};
+    BOOST_CHECK(determinant(swapped) == ll(-2, 1));
+    auto unit = solve(swapped, {ll(1, 1), ll(0, 1), ll(0, 1)});
+    BOOST_CHECK(unit && (*unit)[0] == ll(-9, 2) && (*unit)[1] == ll(-2, 1) && (*unit)[2] == ll(3, 2));
+
+    Matrix<ll> deficient{{ll(1, 2), ll(1, 1), ll(0, 1)}, {ll(1, 1), ll(2, 1), ll(0, 1)}, {ll(0, 1), ll(0, 1), ll(0, 1)}};
+    BOOST_CHECK(rank(deficient) == 1);
+    BOOST_CHECK(determinant(deficient) == ll(0, 1));
+    BOOST_CHECK(!solve(deficient, {ll(1, 1), ll(2, 1), ll(0, 1)}));
+    Matrix<ll> wide{{ll(0, 1), ll(0, 1), ll(1, 1), ll(2, 1)}, {ll(0, 1), ll(0, 1), ll(2, 1), ll(4, 1)}};
+    BOOST_CHECK(rank(wide) == 1);
+
+    /* Hilbert matrix: naive elimination overflows long long long before n = 6 */
+    const std::size_t n = 6;
+    Matrix<ll> hilbert(n, n);
+    std::vector<ll> ones(n, ll(1, 1));
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            hilbert(i, j) = ll(1, (long long) (i + j + 1));
+        }
+    }
+    BOOST_CHECK(determinant(hilbert) == ll(1, 186313420339200000));
+    auto x = solve(hilbert, ones);
+    BOOST_CHECK(x.has_value());
+    for (std::size_t i = 0; x && i < n; ++i) {
+        ll row{0, 1};
+        for (std::size_t j = 0; j < n; ++j) {
+            row += hilbert(i, j) * (*x)[j];
+        }
+        BOOST_CHECK(row == ll(1, 1));
+    }
+
+    constexpr auto max = std::numeric_limits<long long>::max();
+    Matrix<ll> big{{ll(max, 1), ll(1, 1)}, {ll(-1, 1), ll(max, 1)}};
+    bool overflowed = false;
+    try {
+        determinant(big);
+    } catch (overflow::OverflowUnaryError<__int128> const &) {
+        overflowed = true;
+    }
+    BOOST_CHECK(overflowed);
+
+    using flagged = Fractional<long long, overflow::FlagOnCheck>;
+    Matrix<flagged> flagged_big{{flagged(max, 1), flagged(1, 1)}, {flagged(-1, 1), flagged(max, 1)}};
+    overflow::OverflowStatus::Clear();
+    determinant(flagged_big);
+    BOOST_CHECK(overflow::OverflowStatus::Test(overflow::OverflowFlags::Multiply));
+    overflow::OverflowStatus::Clear();
+
+    std::size_t invalid = 0;
+    try {
+        determinant(Matrix<ll>(2, 3));
+    } catch (std::invalid_argument const &) {
+        ++invalid;
+    }
+    try {
+        solve(small, {ll(1, 1)});
+    } catch (std::invalid_argument const &) {
+        ++invalid;
+    }
+    BOOST_CHECK(invalid == 2);
+
+    /* Blocked and threaded elimination agrees with the serial one */
+    const std::size_t m = 40;
+    Matrix<big_fraction> random(m, m);
+    std::vector<big_fraction> rhs;
+    std::mt19937 generator(15);
+    std::uniform_int_distribution<int> entries(-9, 9);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < m; ++j) {
+            random(i, j) = big_fraction(entries(generator), 1 + int(i % 3));
+        }
+        rhs.emplace_back(entries(generator), 1);
+    }
+    EliminationOptions serial{1};
+    EliminationOptions threaded{4, 7, 3, 1};
+    BOOST_CHECK(determinant(random, serial) == determinant(random, threaded));
+    BOOST_CHECK(rank(random, threaded) == m);
+    auto solution = solve(random, rhs, threaded);
+    BOOST_CHECK(solution.has_value());
+    for (std::size_t i = 0; solution && i < m; ++i) {
+        big_fraction row{0, 1};
+        for (std::size_t j = 0; j < m; ++j) {
+            row += random(i, j) * (*solution)[j];
+        }
+        BOOST_CHECK(row == rhs[i]);
+    }
+}
+
+void test_instrumentation() {
+    using namespace fractional;
+    using overflow::Telemetry;
+    using counted = Fractional<int, overflow::Instrumented<overflow::ThrowOnCheck>::OnCheck>;
+    using counted_big = Fractional<BigInteger, overflow::Instrumented<overflow::NoCheck>::OnCheck>;
+
+    counted sum{1, 6}, addend{1, 6};
+    Telemetry::Reset();
+    sum += addend;
+    auto same = Telemetry::Collect();
+    BOOST_CHECK(sum == counted(1, 3));
+    BOOST_CHECK(same.same_denominator == 1);
+    BOOST_CHECK(same.operations[Telemetry::Plus] == 1);
+    BOOST_CHECK(same.widths[2] == 1);
+    BOOST_CHECK(same.gcd_calls == 1 && same.gcd_iterations > 0);
+    BOOST_CHECK(same.lcm_calls == 0);
+
+    Telemetry::Reset();
+    sum += counted(1, 4);
+    auto mixed = Telemetry::Collect();
+    BOOST_CHECK(sum == counted(7, 12));
+    BOOST_CHECK(mixed.same_denominator == 0 && mixed.lcm_calls == 1);
+    BOOST_CHECK(mixed.operations[Telemetry::Multiply] == 3);
+    BOOST_CHECK(mixed.operations[Telemetry::Plus] == 1);
+    BOOST_CHECK(mixed.near_misses(31) == 0);
+
+    Telemetry::Reset();
+    counted large{std::numeric_limits<int>::max() / 2, 1};
+    large *= counted(1, 1);
+    large -= counted(1, 1);
+    BOOST_CHECK(Telemetry::Collect().near_misses(31, 2) == 2);
+    bool overflowed = false;
+    try {
+        large * counted(4, 1);
+    } catch (counted::Checker::BinaryError const &) {
+        overflowed = true;
+    }
+    BOOST_CHECK(overflowed);
+
+    Telemetry::Reset();
+    std::thread worker([] {
+        counted_big value{1, 3};
+        counted_big factor{BigInteger(1) << 70u, 3};
+        for (int i = 0; i < 100; ++i) {
+            value *= factor;
+        }
+    });
+    worker.join();
+    auto big = Telemetry::Collect();
+    BOOST_CHECK(big.operations[Telemetry::Multiply] == 200);
+    BOOST_CHECK(big.widths[Telemetry::WidthBuckets - 1] > 0);
+    BOOST_CHECK(big.gcd_calls == 2 + 300);
+    Telemetry::Reset();
+    BOOST_CHECK(Telemetry::Collect().gcd_calls == 0);
+}
+
+void test_serialization() {
+    using namespace fractional;
+    using frac64 = Fractional<std::int64_t>;
+
+    BOOST_CHECK(binary::crc32c("123456789", 9) == 0xE3069283u);
+    BOOST_CHECK(binary::crc32c("6789", 4, binary::crc32c("12345", 5)) == 0xE3069283u);
+
+    std::vector<frac64> values;
+    for (int i = 0; i < 10; ++i) {
+        values.emplace_back(i - 5, 7);
+    }
+    for (int i = 0; i < 13; ++i) {
+        values.emplace_back(std::numeric_limits<std::int64_t>::min() / (i + 2), i + 1);
+    }
+    values.emplace_back(std::numeric_limits<std::int64_t>::max(), 1);
+
+    std::stringstream stream;
+    binary::Writer<frac64> writer(stream, 5);
+    writer.write(values.data(), 10);
+    for (auto i = values.begin() + 10; i != values.end(); ++i) {
+        writer.write(*i);
+    }
+    writer.finish();
+    BOOST_CHECK(writer.count() == values.size());
+    auto image = stream.str();
+    BOOST_CHECK(image.size() < values.size() * 2 * sizeof(std::int64_t));
+
+    std::stringstream in(image);
+    binary::Reader<frac64> reader(in);
+    std::vector<frac64> restored(values.size() + 1, frac64(0, 1));
+    auto first = reader.read(restored.data(), 7);
+    auto rest = reader.read(restored.data() + first, restored.size() - first);
+    BOOST_CHECK(first == 7 && first + rest == values.size());
+    BOOST_CHECK(reader.done());
+    BOOST_CHECK(std::equal(values.begin(), values.end(), restored.begin()));
+
+    std::stringstream lanes_in(image);
+    binary::Reader<Fractional<std::int32_t>> narrow(lanes_in);
+    FractionVector<std::int32_t> lanes;
+    BOOST_CHECK(narrow.read(lanes, 10) == 10);
+    BOOST_CHECK(lanes.nominators()[0] == -5 && lanes.denominators()[9] == 7);
+    bool out_of_range = false;
+    try {
+        narrow.read(lanes, 1);
+    } catch (binary::FormatError const &) {
+        out_of_range = true;
+    }
+    BOOST_CHECK(out_of_range);
+
+    int rejected = 0;
+    for (auto position : {std::size_t(10), image.size() / 2, image.size() - 1}) {
+        auto corrupted = image;
+        corrupted[position] = char(corrupted[position] ^ 0x10);
+        std::stringstream bad(corrupted);
+        binary::Reader<frac64> bad_reader(bad);
+        try {
+            while (bad_reader.read(restored.data(), restored.size()) != 0);
+        } catch (binary::FormatError const &) {
+            ++rejected;
+        }
+    }
+    std::stringstream truncated(image.substr(0, image.size() - 3));
+    binary::Reader<frac64> truncated_reader(truncated);
+    try {
+        while (truncated_reader.read(restored.data(), restored.size()) != 0);
+    } catch (binary::FormatError const &) {
+        ++rejected;
+    }
+    std::stringstream unsigned_in(image);
+    try {
+        binary::Reader<Fractional<std::uint64_t>> unsigned_reader(unsigned_in);
+    } catch (binary::FormatError const &) {
+        ++rejected;
+    }
+    BOOST_CHECK(rejected == 5);
+
+    FractionVector<std::int64_t> columns;
+    for (std::int64_t i = 0; i < 100; ++i) {
+        columns.push_back(i * i - 50, i % 7 + 1);
+    }
+    auto path = (std::filesystem::temp_directory_path() / "fractional_test_columns.bin").string();
+    {
+        std::ofstream file(path, std::ios::binary);
+        binary::write_columns(file, columns);
+    }
+    {
+        binary::MappedColumns<std::int64_t> mapped(path);
+        BOOST_CHECK(mapped.size() == 100 && !mapped.shared());
+        BOOST_CHECK(mapped.verify());
+        BOOST_CHECK(reinterpret_cast<std::uintptr_t>(mapped.nominators()) % 64 == 0);
+        BOOST_CHECK(reinterpret_cast<std::uintptr_t>(mapped.denominators()) % 64 == 0);
+        BOOST_CHECK(mapped.at<frac64>(10) == frac64(50, 4));
+        auto moved = std::move(mapped);
+        BOOST_CHECK(moved.size() == 100 && mapped.size() == 0);
+        BOOST_CHECK(moved.denominator(99) == 99 % 7 + 1);
+    }
+    bool wrong_type = false;
+    try {
+        binary::MappedColumns<std::int32_t> mapped(path);
+    } catch (binary::FormatError const &) {
+        wrong_type = true;
+    }
+    BOOST_CHECK(wrong_type);
+    std::remove(path.c_str());
+
+    std::vector<std::uint16_t> nominators{1, 2, 3}, denominators{8, 8, 8};
+    std::stringstream shared;
+    binary::write_columns(shared, nominators.data(), denominators.data(), nominators.size());
+    auto shared_image = shared.str();
+    std::vector<std::uint64_t> buffer(shared_image.size() / 8 + 1);
+    std::memcpy(buffer.data(), shared_image.data(), shared_image.size());
+    binary::ColumnView<std::uint16_t> view(buffer.data(), shared_image.size());
+    BOOST_CHECK(view.shared() && view.denominators() == nullptr);
+    BOOST_CHECK(view.at<Fractional<std::uint16_t>>(1) == Fractional<std::uint16_t>(1, 4));
+    BOOST_CHECK(view.verify());
+    reinterpret_cast<unsigned char *>(buffer.data())[64] ^= 1u;
+    BOOST_CHECK(!view.verify());
+}
+
+template<class _Fixed>
+void test_fixed_rescaling(std::mt19937_64 &random) {
+    using NaturalType = typename _Fixed::NaturalType;
+    using Wide = __int128;
+    constexpr Wide denominator = _Fixed::Denominator;
+
+    std::uniform_int_distribution<NaturalType> values(std::numeric_limits<NaturalType>::min() / 2,
+                                                      std::numeric_limits<NaturalType>::max() / 2);
+    int mismatches = 0;
+    for (int i = 0; i < 2000; ++i) {
+        auto lhs = values(random), rhs = values(random) >> (i % std::numeric_limits<NaturalType>::digits);
+        auto product = Wide(lhs) * rhs;
+        auto quotient = product / denominator, remainder = product % denominator;
+        if (2 * (remainder < 0 ? -remainder : remainder) >= denominator)
+            quotient += product < 0 ? -1 : 1;
+        if (quotient < std::numeric_limits<NaturalType>::min() || quotient > std::numeric_limits<NaturalType>::max())
+            continue;
+        auto result = _Fixed::from_nominator(lhs) * _Fixed::from_nominator(rhs);
+        mismatches += result.nominator() != NaturalType(quotient);
+    }
+    BOOST_CHECK(mismatches == 0);
+}
+
+void test_fixed_fractional() {
+    using namespace fractional;
+    using cents = FixedFractional<long long, 100>;
+    using ticks = FixedFractional<int, 48000>;
+
+    static_assert(sizeof(cents) == sizeof(long long) && sizeof(ticks) == sizeof(int));
+    static_assert((cents(1) + cents::from_nominator(5)).nominator() == 105);
+
+    auto price = cents::from_nominator(125);
+    BOOST_CHECK(price + cents::from_nominator(250) == cents::from_nominator(375));
+    BOOST_CHECK(price - cents(2) == cents::from_nominator(-75));
+    BOOST_CHECK(-price < price && price <= price && cents(2) > price);
+    BOOST_CHECK(price * 3LL == cents::from_nominator(375) && 3LL * price == price * 3LL);
+    BOOST_CHECK(price * price == cents::from_nominator(156));
+    BOOST_CHECK(-price * price == cents::from_nominator(-156));
+    BOOST_CHECK(cents::from_nominator(5) * cents::from_nominator(10) == cents::from_nominator(1));
+    BOOST_CHECK(cents::from_nominator(-5) * cents::from_nominator(10) == cents::from_nominator(-1));
+    BOOST_CHECK(cents(1) / cents(3) == cents::from_nominator(33));
+    BOOST_CHECK(cents(-2) / cents(3) == cents::from_nominator(-67));
+    BOOST_CHECK(double(price) == 1.25);
+    BOOST_CHECK(price.fraction() == Fractional<long long>(5, 4));
+    Fractional<long long, overflow::NoCheck> converted = price;
+    BOOST_CHECK((converted == Fractional<long long, overflow::NoCheck>(5, 4)));
+
+    BOOST_CHECK(cents(Fractional<long long>(-3, 4)) == cents::from_nominator(-75));
+    BOOST_CHECK(cents::nearest(Fractional<long long>(1, 3)) == cents::from_nominator(33));
+    BOOST_CHECK(cents::nearest(Fractional<long long>(-1, 200)) == cents::from_nominator(-1));
+    BOOST_CHECK(ticks(Fractional<int>(1, 960)) == ticks::from_nominator(50));
+    BOOST_CHECK(ticks::from_nominator(24000) * ticks::from_nominator(3) == ticks::from_nominator(2));
+
+    int rejected = 0;
+    try {
+        cents(Fractional<long long>(1, 3));
+    } catch (std::domain_error const &) {
+        ++rejected;
+    }
+    try {
+        cents::from_nominator(std::numeric_limits<long long>::max()) * cents(2);
+    } catch (overflow::OverflowBinaryError<long long, long long> const &) {
+        ++rejected;
+    }
+    try {
+        price / cents::from_nominator(0);
+    } catch (cents::Checker::BinaryError const &) {
+        ++rejected;
+    }
+    try {
+        cents::from_nominator(std::numeric_limits<long long>::max()) + price;
+    } catch (cents::Checker::BinaryError const &) {
+        ++rejected;
+    }
+    BOOST_CHECK(rejected == 4);
+
+    using flagged = FixedFractional<int, 100, overflow::FlagOnCheck>;
+    overflow::OverflowStatus::Clear();
+    auto unchanged = flagged::from_nominator(5) / flagged::from_nominator(0);
+    BOOST_CHECK(unchanged.nominator() == 5);
+    BOOST_CHECK(overflow::OverflowStatus::Test() == overflow::OverflowFlags::Divide);
+    overflow::OverflowStatus::Clear();
+
+    static_assert(flagged::IsNothrow && !cents::IsNothrow);
+    static_assert(noexcept(flagged(1) * flagged(1)) && noexcept(flagged(1) / flagged(1)));
+    auto large = flagged::from_nominator(std::numeric_limits<int>::max());
+    auto wrapped = large * flagged(2);
+    BOOST_CHECK(wrapped.nominator() == -2);
+    BOOST_CHECK(overflow::OverflowStatus::Test() == overflow::OverflowFlags::Multiply);
+    overflow::OverflowStatus::Clear();
+    large / flagged::from_nominator(50);
+    BOOST_CHECK(overflow::OverflowStatus::Test() == overflow::OverflowFlags::Multiply);
+    overflow::OverflowStatus::Clear();
+    flagged::nearest(Fractional<int>(std::numeric_limits<int>::max(), 3));
+    BOOST_CHECK(overflow::OverflowStatus::Test() == overflow::OverflowFlags::Multiply);
+    overflow::OverflowStatus::Clear();
+    using unchecked = FixedFractional<std::int64_t, 1000, overflow::NoCheck>;
+    auto big = unchecked::from_nominator(std::numeric_limits<std::int64_t>::max());
+    BOOST_CHECK((big * big).nominator() == std::int64_t(-1789334175149826507LL));
+
+    std::ostringstream os;
+    os << price << ' ' << ticks(2);
+    BOOST_CHECK(os.str() == "5/4 2/1");
+
+    std::mt19937_64 random(18);
+    test_fixed_rescaling<cents>(random);
+    test_fixed_rescaling<FixedFractional<std::int64_t, 1>>(random);
+    test_fixed_rescaling<FixedFractional<std::int64_t, 48000>>(random);
+    test_fixed_rescaling<FixedFractional<std::int64_t, (std::int64_t(1) << 62) + 7>>(random);
+    test_fixed_rescaling<FixedFractional<std::uint64_t, 1000000007>>(random);
+    test_fixed_rescaling<FixedFractional<std::int32_t, 1000>>(random);
+}
+
+void test_ordering() {
+    using namespace fractional;
+    using none = Fractional<int, overflow::ThrowOnCheck, overflow::IntegralCheckOverflow, normalization::None>;
+    using lazy = Fractional<long long, overflow::ThrowOnCheck, overflow::IntegralCheckOverflow, normalization::Lazy<>>;
+
+    constexpr auto max = std::numeric_limits<std::int64_t>::max();
+    Fractional<std::int64_t> close{max - 1, max}, closer{max - 2, max - 1};
+    BOOST_CHECK(closer < close && close > closer && Compare(close, close) == 0);
+    BOOST_CHECK(Compare(Fractional<std::int64_t>(-max, max - 1), Fractional<std::int64_t>(-max + 1, max - 2)) > 0);
+    constexpr auto max128 = std::numeric_limits<__int128>::max();
+    BOOST_CHECK((Fractional<__int128>(max128 - 2, max128 - 1) < Fractional<__int128>(max128 - 1, max128)));
+    BOOST_CHECK((Fractional<std::uint64_t>(~0ull - 1, ~0ull) > Fractional<std::uint64_t>(~0ull - 2, ~0ull - 1)));
+    BOOST_CHECK(none(2, 4) == none(-1, -2) && none(1, -3) < none(1, 4));
+
+    BOOST_CHECK(std::hash<none>{}(none(2, 4)) == std::hash<none>{}(none(1, 2)));
+    BOOST_CHECK(std::hash<none>{}(none(-1, -2)) == std::hash<none>{}(none(1, 2)));
+    BOOST_CHECK(std::hash<none>{}(none(0, 5)) == std::hash<none>{}(none(0, -1)));
+    BOOST_CHECK(std::hash<fraction>{}(fraction(1, 2)) != std::hash<fraction>{}(fraction(2, 1)));
+    BOOST_CHECK(std::hash<lazy>{}(lazy(6, 9)) == std::hash<lazy>{}(lazy(2, 3)));
+    BOOST_CHECK(std::hash<big_fraction>{}(big_fraction(BigInteger(6) << 80u, 9)) ==
+                std::hash<big_fraction>{}(big_fraction(BigInteger(2) << 80u, 3)));
+    BOOST_CHECK(std::hash<BigInteger>{}(BigInteger(1) << 70u) != std::hash<BigInteger>{}(-(BigInteger(1) << 70u)));
+
+    std::unordered_set<none, std::hash<none>> distinct;
+    for (int i = 1; i <= 12; ++i) {
+        distinct.insert(none(i, 2 * i));
+        distinct.insert(none(-i, -3 * i));
+    }
+    BOOST_CHECK(distinct.size() == 2);
+
+    std::mt19937_64 random(19);
+    std::uniform_int_distribution<std::int64_t> nominators(-max, max), denominators(1, max);
+    std::vector<Fractional<std::int64_t>> values;
+    for (int i = 0; i < 6000; ++i) {
+        switch (i % 3) {
+            case 0:
+                values.emplace_back(nominators(random), denominators(random));
+                break;
+            case 1:
+                values.emplace_back(max - std::int64_t(random() % 64), max - std::int64_t(random() % 64));
+                break;
+            default:
+                values.emplace_back(std::int64_t(random() % 7) - 3, std::int64_t(random() % 5) + 1);
+        }
+    }
+    auto expected = values;
+    std::sort(expected.begin(), expected.end());
+    radix_sort(values.data(), values.data() + values.size());
+    BOOST_CHECK(values == expected);
+
+    std::vector<lazy> small;
+    for (int i = 0; i < 100; ++i) {
+        small.emplace_back(std::int64_t(random() % 1000) - 500, std::int64_t(random() % 30) + 1);
+    }
+    auto small_expected = small;
+    std::sort(small_expected.begin(), small_expected.end());
+    radix_sort(small.data(), small.data() + small.size(), SortOptions{16});
+    BOOST_CHECK(std::equal(small.begin(), small.end(), small_expected.begin()));
+}
+
+void test_block_cache() {
+    using namespace fractional;
+
+    fraction half{1, 2}, third{1, 3};
+    BOOST_CHECK(fraction(half) + third == fraction(5, 6) && half + fraction(third) == fraction(5, 6));
+    BOOST_CHECK(fraction(half) - third == fraction(1, 6) && fraction(half) / third == fraction(3, 2));
+    BOOST_CHECK(fraction(half) * fraction(third) == fraction(1, 6) && Plus(fraction(half), third) == fraction(5, 6));
+
+    auto big = big_fraction(BigInteger(1) << 100u, 3);
+    auto moved = big_fraction(big);
+    auto sum = std::move(moved) + big;
+    BOOST_CHECK(sum == big_fraction(BigInteger(1) << 101u, 3));
+    BOOST_CHECK(big * big_fraction(3, 1) == big_fraction(BigInteger(1) << 100u, 1));
+
+    /* Once the cache holds blocks of every recurring size the loop stops calling operator new */
+    auto cache = memory::BlockCache::Local();
+    BOOST_CHECK(cache != nullptr);
+    auto run = [&big] {
+        big_fraction total{0, 1};
+        for (int k = 1; k <= 64; ++k) {
+            total = std::move(total) + big_fraction(BigInteger(k) << 70u, BigInteger(k + 1));
+        }
+        return total;
+    };
+    auto warm = run();
+    auto before = cache->statistics();
+    for (int i = 0; i < 8; ++i) {
+        BOOST_CHECK(run() == warm);
+    }
+    auto after = cache->statistics();
+    BOOST_CHECK(after.system == before.system && after.hits > before.hits);
+
+    BOOST_CHECK(memory::BlockCache::BlockSize(17, alignof(std::uint64_t)) == 32);
+    BOOST_CHECK(memory::BlockCache::BlockSize(std::size_t(1) << 20u, 8) == std::size_t(1) << 20u);
+    std::thread([&warm] {
+        auto copy = warm;
+        BOOST_CHECK(copy == warm && memory::BlockCache::Local() != nullptr);
+    }).join();
+    cache->release();
+    BOOST_CHECK(run() == warm);
+
+    /* A cache of its own leaves the one of the thread in place */
+    {
+        memory::BlockCache mine;
+        mine.deallocate(mine.allocate(24), 24);
+        BOOST_CHECK(mine.statistics().allocations == 1);
+    }
+    BOOST_CHECK(memory::BlockCache::Local() == cache);
+}
+
+void test_accumulator() {
+    using namespace fractional;
+    using none = Fractional<int, overflow::ThrowOnCheck, overflow::IntegralCheckOverflow, normalization::None>;
+
+    RationalAccumulator<fraction> ledger;
+    fraction expected{0, 1};
+    for (int i = 0; i < 1000; ++i) {
+        fraction value{(i % 11 - 5) | 1, i % 3 == 0 ? 101 : i % 3 == 1 ? 13 : 7};
+        ledger += value;
+        expected += value;
+    }
+    BOOST_CHECK(ledger.pending() == 3 && ledger.result() == expected && ledger.pending() == 0);
+    ledger -= fraction(1, 7);
+    BOOST_CHECK(ledger.result() == expected - fraction(1, 7));
+
+    /* Distinct denominators beyond 3/4 of the table force intermediate merges */
+    RationalAccumulator<Fractional<long long>> harmonic(4);
+    Fractional<long long> partial{0, 1};
+    for (long long k = 1; k <= 20; ++k) {
+        harmonic += Fractional<long long>(1, k);
+        partial += Fractional<long long>(1, k);
+        BOOST_CHECK(harmonic.pending() <= 3);
+    }
+    BOOST_CHECK(harmonic.result() == partial);
+    harmonic.clear();
+    BOOST_CHECK(harmonic.pending() == 0 && harmonic.result() == Fractional<long long>(0, 1));
+
+    std::vector<none> terms{none(2, 4), none(-1, -2), none(1, 3), none(-2, 6)};
+    RationalAccumulator<none> unreduced;
+    BOOST_CHECK(unreduced.add(terms.begin(), terms.end()).result() == none(1, 1));
+
+    RationalAccumulator<big_fraction> big;
+    for (int k = 0; k < 100; ++k) {
+        big += big_fraction(BigInteger(1) << 90u, 3);
+    }
+    BOOST_CHECK(big.result() == big_fraction(BigInteger(100) << 90u, 3));
+
+    RationalAccumulator<Fractional<std::int8_t>> narrow;
+    int overflows = 0;
+    try {
+        for (int i = 0; i < 200; ++i) {
+            narrow += Fractional<std::int8_t>(1, 3);
+        }
+    } catch (overflow::OverflowBinaryError<std::int8_t, std::int8_t> const &) {
+        ++overflows;
+    }
+    BOOST_CHECK(overflows == 1);
+
+    /* An overflow while merging leaves every term in place */
+    RationalAccumulator<Fractional<int>> failed;
+    failed += Fractional<int>(2000000000, 3);
+    failed += Fractional<int>(1, 43);
+    try {
+        failed.result();
+    } catch (overflow::OverflowBinaryError<int, int> const &) {
+        ++overflows;
+    }
+    BOOST_CHECK(overflows == 2 && failed.pending() == 2);
+    failed -= Fractional<int>(2000000000, 3);
+    failed += Fractional<int>(1, 2);
+    BOOST_CHECK(failed.result() == Fractional<int>(45, 86));
+}
+
+void test_rounding() {
+    using namespace fractional;
+    using none = Fractional<int, overflow::ThrowOnCheck, overflow::IntegralCheckOverflow, normalization::None>;
+    using i64 = Fractional<std::int64_t>;
+
+    BOOST_CHECK(floor(fraction(7, 2)) == 3 && floor(fraction(-7, 2)) == -4 && floor(fraction(-6, 2)) == -3);
+    BOOST_CHECK(ceil(fraction(7, 2)) == 4 && ceil(fraction(-7, 2)) == -3 && ceil(fraction(6, 2)) == 3);
+    BOOST_CHECK(trunc(fraction(7, 2)) == 3 && trunc(fraction(-7, 2)) == -3);
+    BOOST_CHECK(round(fraction(5, 2)) == 2 && round(fraction(7, 2)) == 4 && round(fraction(-5, 2)) == -2);
+    BOOST_CHECK(round(fraction(-7, 2)) == -4 && round(fraction(8, 3)) == 3 && round(fraction(-8, 3)) == -3);
+    BOOST_CHECK(floor(none(7, -2)) == -4 && ceil(none(-7, -2)) == 4 && round(none(5, -2)) == -2);
+    BOOST_CHECK(round(none(-7, -3)) == 2 && round(none(7, -3)) == -2);
+
+    /* Beyond the long double mantissa the integer part is still exact */
+    constexpr auto max = std::numeric_limits<std::int64_t>::max();
+    BOOST_CHECK(floor(i64(max, 1)) == max && floor(i64(max - 1, 2)) == max / 2 && ceil(i64(max, 2)) == max / 2 + 1);
+    BOOST_CHECK(floor(i64(-max, 2)) == -(max / 2) - 1 && round(i64(max, 2)) == max / 2 + 1);
+
+    auto parts = divmod(fraction(-7, 3));
+    BOOST_CHECK(parts.quotient == -3 && parts.remainder == fraction(2, 3));
+    auto unreduced = divmod(none(7, -3));
+    BOOST_CHECK(unreduced.quotient == -3 && unreduced.remainder == none(2, 3));
+    BOOST_CHECK(abs(fraction(-3, 4)) == fraction(3, 4) && abs(none(-3, -4)) == none(3, 4));
+    BOOST_CHECK(abs(none(3, -4)) == none(3, 4) && abs(fraction(0, 1)) == fraction(0, 1));
+
+    BOOST_CHECK(mediant(fraction(1, 2), fraction(2, 3)) == fraction(3, 5));
+    BOOST_CHECK(mediant(none(2, 4), none(-2, -3)) == none(3, 5));
+
+    BOOST_CHECK(between(fraction(3, 10), fraction(4, 10)) == fraction(1, 3));
+    BOOST_CHECK(between(fraction(4, 10), fraction(3, 10)) == fraction(1, 3));
+    BOOST_CHECK(between(fraction(-4, 10), fraction(-3, 10)) == fraction(-1, 3));
+    BOOST_CHECK(between(fraction(-1, 2), fraction(3, 7)) == fraction(0, 1));
+    BOOST_CHECK(between(fraction(7, 3), fraction(9, 2)) == fraction(3, 1));
+    BOOST_CHECK(between(fraction(355, 113), fraction(355, 113)) == fraction(355, 113));
+    BOOST_CHECK(between(fraction(314, 100), fraction(315, 100)) == fraction(22, 7));
+    BOOST_CHECK(between(none(-3, -10), none(2, 5)) == none(1, 3));
+    BOOST_CHECK(between(big_fraction(BigInteger(1) << 70u, 3), big_fraction((BigInteger(1) << 70u) + 2, 3)) ==
+                big_fraction(((BigInteger(1) << 70u) + 2) / 3, 1));
+
+    /* Brute force: the least denominator in the interval, then the least magnitude */
+    for (int a = -12; a <= 12; ++a) {
+        for (int b = 1; b <= 7; ++b) {
+            fraction lo{a, b}, hi{a + 1, b + 2};
+            if (hi < lo)
+                continue;
+            auto simplest = between(lo, hi);
+            auto found = false;
+            for (int q = 1; q <= 9 && !found; ++q) {
+                for (int p = 0; p <= 24 && !found; ++p) {
+                    for (int sign : {1, -1}) {
+                        fraction candidate{sign * p, q};
+                        if (!found && lo <= candidate && candidate <= hi) {
+                            BOOST_CHECK(simplest == candidate);
+                            found = true;
+                        }
+                    }
+                }
+            }
+            BOOST_CHECK(found);
+        }
+    }
+
+    std::vector<i64> values{i64(7, 2), i64(-7, 2), i64(5, 2), i64(-1, 3), i64(max, 3)};
+    std::vector<std::int64_t> out(values.size());
+    floor(values.data(), values.data() + values.size(), out.data());
+    BOOST_CHECK((out == std::vector<std::int64_t>{3, -4, 2, -1, max / 3}));
+    ceil(values.data(), values.data() + values.size(), out.data());
+    BOOST_CHECK((out == std::vector<std::int64_t>{4, -3, 3, 0, max / 3 + 1}));
+    trunc(values.data(), values.data() + values.size(), out.data());
+    BOOST_CHECK((out == std::vector<std::int64_t>{3, -3, 2, 0, max / 3}));
+    round(values.data(), values.data() + values.size(), out.data());
+    BOOST_CHECK((out == std::vector<std::int64_t>{4, -4, 2, 0, max / 3}));
+
+    int overflows = 0;
+    try {
+        floor(Fractional<std::int8_t>(-128, -1));
+    } catch (...) {
+        ++overflows;
+    }
+    BOOST_CHECK(overflows == 1);
+}
+
+void test_kernels() {
+    using namespace fractional;
+    using lazy = Fractional<long long, overflow::ThrowOnCheck, overflow::IntegralCheckOverflow, normalization::Lazy<>>;
+    using flagged = Fractional<std::int32_t, overflow::FlagOnCheck>;
+
+    constexpr std::array<fraction, 4> coefficients{fraction(1, 2), fraction(-2, 3), fraction(0, 1), fraction(5, 7)};
+    static_assert(horner(coefficients, fraction(3, 4)) == fraction(1, 2) - fraction(1, 2) + fraction(135, 448),
+                  "horner is constexpr");
+    static_assert(dot(coefficients, coefficients) == fraction(1, 4) + fraction(4, 9) + fraction(25, 49),
+                  "dot is constexpr");
+    BOOST_CHECK(horner(std::vector<fraction>{}, fraction(3, 4)) == fraction(0, 1));
+    BOOST_CHECK(dot(std::vector<fraction>{}, std::vector<fraction>{}) == fraction(0, 1));
+
+    /* Compared with the scalar loop for every width and a few normalizations */
+    auto check = [](auto tag) {
+        using Fract = decltype(tag);
+        using NaturalType = typename Fract::NaturalType;
+        std::vector<Fract> values, weights;
+        for (int i = 1; i <= 20; ++i) {
+            values.emplace_back(NaturalType(i % 7 + 1), NaturalType(i % 5 + 2));
+            weights.emplace_back(NaturalType(i % 3 + 1), NaturalType(i % 4 + 1));
+        }
+        Fract x{NaturalType(2), NaturalType(3)};
+        Fract polynomial{NaturalType(0), NaturalType(1)}, power{NaturalType(1), NaturalType(1)};
+        Fract weighted{NaturalType(0), NaturalType(1)};
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            polynomial += values[i] * power;
+            power *= x;
+            weighted += values[i] * weights[i];
+        }
+        return horner(values, x) == polynomial && dot(values, weights) == weighted;
+    };
+    BOOST_CHECK(check(Fractional<long long>(0, 1)));
+    BOOST_CHECK(check(Fractional<unsigned long long>(0, 1)));
+    BOOST_CHECK(check(Fractional<__int128>(0, 1)));
+    BOOST_CHECK(check(lazy(0, 1)));
+    BOOST_CHECK(check(big_fraction(0, 1)));
+
+    std::vector<fraction> small{fraction(1, 3), fraction(1, 5), fraction(1, 7), fraction(1, 11)};
+    BOOST_CHECK(dot(small, small) == fraction(1, 9) + fraction(1, 25) + fraction(1, 49) + fraction(1, 121));
+    auto reduced = horner(std::vector<lazy>{lazy(2, 4), lazy(3, 6)}, lazy(4, 8));
+    BOOST_CHECK(reduced.nominator() == 3 && reduced.denominator() == 4);
+
+    /* Overflow is reported where the scalar loop reports it */
+    int overflows = 0;
+    try {
+        std::vector<Fractional<std::int32_t>> large(3, Fractional<std::int32_t>(1 << 30, 1));
+        dot(large, large);
+    } catch (overflow::OverflowBinaryError<std::int32_t, std::int32_t> const &) {
+        ++overflows;
+    }
+    BOOST_CHECK(overflows == 1);
+    std::vector<Fractional<std::int64_t>> primes;
+    for (std::int64_t p : {2, 3, 5, 7, 11, 13, 17, 19, 23}) {
+        primes.emplace_back(1, p);
+    }
+    Fractional<std::int64_t> harmonic{0, 1};
+    for (const auto &value : primes) {
+        harmonic += value * value;
+    }
+    BOOST_CHECK(dot(primes, primes) == harmonic);
+    primes.emplace_back(1, 29);
+    try {
+        dot(primes, primes);
+    } catch (overflow::OverflowBinaryError<std::int64_t, std::int64_t> const &) {
+        ++overflows;
+    }
+    BOOST_CHECK(overflows == 2);
+
+    overflow::OverflowStatus::Clear();
+    dot(std::vector<flagged>(2, flagged(1 << 30, 1)), std::vector<flagged>(2, flagged(4, 1)));
+    BOOST_CHECK(overflow::OverflowStatus::Test() != overflow::OverflowFlags::None);
+    overflow::OverflowStatus::Clear();
+}
+
+void test_atomic_fractional() {
+    using namespace fractional;
+    using none = Fractional<std::int16_t, overflow::ThrowOnCheck, overflow::IntegralCheckOverflow, normalization::None>;
+
+    static_assert(AtomicFractional<fraction>::is_always_lock_free, "one 64-bit word");
+    AtomicFractional<fraction> shared;
+    BOOST_CHECK(shared.load() == fraction(0, 1) && shared.is_lock_free());
+    shared.store(fraction(-3, 4));
+    BOOST_CHECK(shared.load() == fraction(-3, 4) && shared.exchange(fraction(1, 2)) == fraction(-3, 4));
+    BOOST_CHECK(shared.fetch_add(fraction(1, 3)) == fraction(1, 2) && shared.load() == fraction(5, 6));
+    BOOST_CHECK((shared -= fraction(1, 6)) == fraction(2, 3) && (shared += fraction(1, 3)) == fraction(1, 1));
+
+    auto expected = fraction(1, 2);
+    BOOST_CHECK(!shared.compare_exchange_strong(expected, fraction(7, 8)) && expected == fraction(1, 1));
+    BOOST_CHECK(shared.compare_exchange_strong(expected, fraction(7, 8)) && shared.load() == fraction(7, 8));
+
+    AtomicFractional<none> unreduced{none(2, -4)};
+    BOOST_CHECK(unreduced.load().nominator() == 2 && unreduced.load().denominator() == -4);
+    auto half = none(1, 2);
+    BOOST_CHECK(!unreduced.compare_exchange_strong(half, none(0, 1)) && half.denominator() == -4);
+
+    /* A throwing checker leaves the stored value as it was */
+    AtomicFractional<fraction> large{fraction(std::numeric_limits<int>::max(), 1)};
+    int overflows = 0;
+    try {
+        large.fetch_add(fraction(1, 1));
+    } catch (overflow::OverflowBinaryError<int, int> const &) {
+        ++overflows;
+    }
+    BOOST_CHECK(overflows == 1 && large.load() == fraction(std::numeric_limits<int>::max(), 1));
+
+    AtomicFractional<fraction> counter;
+    ShardedFractional<fraction> sharded(3);
+    BOOST_CHECK(sharded.shards() == 3 && ShardedFractional<fraction>().shards() >= 1);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&counter, &sharded, t] {
+            for (int i = 0; i < 1000; ++i) {
+                counter.fetch_add(fraction(1, t + 2));
+                sharded.add(fraction(1, t + 2));
+                sharded.subtract(fraction(1, 12));
+            }
+        });
+    }
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    auto total = fraction(1000, 2) + fraction(1000, 3) + fraction(1000, 4) + fraction(1000, 5);
+    BOOST_CHECK(counter.load() == total && sharded.load() == total - fraction(4000, 12));
+}
+
 int test_main(int, char *[]) {
     using namespace fractional;
     using namespace fractional::overflow;
@@ -134,7 +1630,59 @@ int test_main(int, char *[]) {
     test_fraction<fraction>();
     test_fraction<Fractional<int, overflow::NoCheck>>();
 
+    test_fraction_arithmetic<fraction>();
+    test_fraction_arithmetic<Fractional<long long>>();
+    test_fraction_arithmetic<Fractional<int, overflow::NoCheck>>();
+
+    test_normalization();
+
+    test_gcd();
+
+    test_widening();
+
+    test_big_integer();
+
+    test_fraction_vector<std::int8_t>();
+    test_fraction_vector<std::int16_t>();
+    test_fraction_vector<std::int32_t>();
+    test_fraction_vector<std::uint32_t>();
+    test_fraction_vector<std::int64_t>();
+    test_fraction_vector<std::uint64_t>();
+
+    test_parallel_reduce();
+
+    test_flag_on_check();
+
+    test_charconv();
+
+    test_approximate();
+
+    test_floating_conversion();
+
+    test_constexpr();
+
+    test_matrix();
+
+    test_instrumentation();
+
+    test_serialization();
+
+    test_fixed_fractional();
+
+    test_ordering();
+
+    test_block_cache();
+
+    test_accumulator();
+
+    test_rounding();
+
+    test_kernels();
+
+    test_atomic_fractional();
+
     test_overflow_max();
+    test_builtin_overflow();
 
     return boost::exit_success;
 }
\ No newline at end of file